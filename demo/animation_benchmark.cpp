@@ -0,0 +1,62 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "animation_benchmark.hpp"
+
+#include <borealis.hpp>
+#include <memory>
+#include <vector>
+
+static constexpr int ANIMATIONS = 10000;
+static constexpr int FRAMES     = 1000;
+static constexpr int EASINGS    = (int)brls::EasingFunction::backInOut + 1;
+
+void runAnimationBenchmark()
+{
+    // Step frames by hand, for every run to evaluate the same positions
+    brls::ManualClock clock;
+    brls::Clock::setCurrent(&clock);
+    brls::Ticking::updateTickings();
+
+    std::vector<std::unique_ptr<brls::Animatable>> animatables;
+    animatables.reserve(ANIMATIONS);
+
+    for (int i = 0; i < ANIMATIONS; i++)
+    {
+        // Long enough for every animation to run until the end of the benchmark
+        auto animatable = std::make_unique<brls::Animatable>(0.0f);
+        animatable->addStep(1.0f, FRAMES * 20, (brls::EasingFunction)(i % EASINGS));
+        animatable->start();
+
+        animatables.push_back(std::move(animatable));
+    }
+
+    brls::Time time = 0;
+
+    for (int i = 0; i < FRAMES; i++)
+    {
+        clock.advance(16667);
+
+        brls::Time start = brls::getCPUTimeUsec();
+        brls::Ticking::updateTickings();
+        time += brls::getCPUTimeUsec() - start;
+    }
+
+    animatables.clear();
+    brls::Clock::setCurrent(nullptr);
+
+    brls::Logger::info("Benchmark: {} animations updated in {} us per frame on average", ANIMATIONS, time / FRAMES);
+}
@@ -0,0 +1,72 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "async_benchmark.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <borealis.hpp>
+#include <thread>
+
+static constexpr int LATENCY_ROUNDS   = 1000;
+static constexpr int THROUGHPUT_TASKS = 10000;
+
+static void runLatencyBenchmark()
+{
+    brls::Time total = 0;
+    brls::Time worst = 0;
+
+    for (int i = 0; i < LATENCY_ROUNDS; i++)
+    {
+        std::atomic<brls::Time> start = 0;
+
+        // One task at a time, for the workers to be asleep when it's submitted
+        brls::Time submit = brls::getCPUTimeUsec();
+        brls::async([&start] { start = brls::getCPUTimeUsec(); });
+
+        while (start == 0)
+            std::this_thread::yield();
+
+        brls::Time latency = start - submit;
+        total += latency;
+        worst = std::max(worst, latency);
+    }
+
+    brls::Logger::info("Benchmark: submit to start: {} us average, {} us worst over {} tasks", total / LATENCY_ROUNDS, worst, LATENCY_ROUNDS);
+}
+
+static void runThroughputBenchmark()
+{
+    std::atomic<int> done = 0;
+
+    brls::Time start = brls::getCPUTimeUsec();
+
+    for (int i = 0; i < THROUGHPUT_TASKS; i++)
+        brls::async([&done] { done++; });
+
+    while (done < THROUGHPUT_TASKS)
+        std::this_thread::yield();
+
+    brls::Time time = brls::getCPUTimeUsec() - start;
+
+    brls::Logger::info("Benchmark: {} tasks done in {} us on {} workers", THROUGHPUT_TASKS, time, brls::Threading::getWorkersCount());
+}
+
+void runAsyncBenchmark()
+{
+    runLatencyBenchmark();
+    runThroughputBenchmark();
+}
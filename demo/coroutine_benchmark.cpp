@@ -0,0 +1,96 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "coroutine_benchmark.hpp"
+
+#include <borealis.hpp>
+#include <thread>
+
+#ifdef BRLS_COROUTINES
+
+static constexpr int FRAMES    = 1000;
+static constexpr int HOPS      = 1000;
+static constexpr long DELAY_MS = 100;
+
+static brls::UiTask stepFrames(int* frames)
+{
+    for (int i = 0; i < FRAMES; i++)
+    {
+        co_await brls::nextFrame();
+        (*frames)++;
+    }
+}
+
+static brls::UiTask hopThreads(int* hops)
+{
+    for (int i = 0; i < HOPS; i++)
+    {
+        co_await brls::background();
+        co_await brls::mainThread();
+        (*hops)++;
+    }
+}
+
+static brls::UiTask waitDelay(bool* done)
+{
+    co_await brls::delay(DELAY_MS);
+    *done = true;
+}
+
+// Runs the main thread part of the main loop until the condition is met
+template <typename F>
+static brls::Time runUntil(F condition)
+{
+    brls::Time start = brls::getCPUTimeUsec();
+
+    while (!condition())
+    {
+        brls::Threading::performSyncTasks();
+        std::this_thread::yield();
+    }
+
+    return brls::getCPUTimeUsec() - start;
+}
+
+void runCoroutineBenchmark()
+{
+    int frames = 0;
+    stepFrames(&frames);
+
+    brls::Time time = runUntil([&frames] { return frames == FRAMES; });
+    brls::Logger::info("Benchmark: {} frames stepped in {} us per frame on average", FRAMES, time / FRAMES);
+
+    int hops = 0;
+    hopThreads(&hops);
+
+    time = runUntil([&hops] { return hops == HOPS; });
+    brls::Logger::info("Benchmark: {} main thread to worker round trips in {} us on average", HOPS, time / HOPS);
+
+    bool done = false;
+    waitDelay(&done);
+
+    time = runUntil([&done] { return done; });
+    brls::Logger::info("Benchmark: {} ms delay resumed after {} us", DELAY_MS, time);
+}
+
+#else
+
+void runCoroutineBenchmark()
+{
+    brls::Logger::error("Coroutines need C++20, build the demo with -Dcoroutines=true or COROUTINES=1");
+}
+
+#endif
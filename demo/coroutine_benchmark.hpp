@@ -0,0 +1,23 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+// Runs UiTask coroutines stepping frames, hopping between the main thread
+// and the workers and waiting on a delay, then measures how long each took.
+// Needs a C++20 build (meson configure -Dcoroutines=true, or make COROUTINES=1).
+// Run the demo with --benchmark-coroutines to use it.
+void runCoroutineBenchmark();
@@ -0,0 +1,93 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "inflate_benchmark.hpp"
+
+#include <borealis.hpp>
+#include <cstring>
+
+static const char* LAYOUTS[] = {
+    "xml/tabs/components.xml",
+    "xml/tabs/settings.xml",
+    "xml/tabs/scroll_test.xml",
+    "xml/tabs/recycling_list.xml",
+    "xml/views/pokemon.xml",
+    "xml/views/captioned_image.xml",
+    "xml/cells/cell.xml",
+};
+
+static constexpr int ITERATIONS = 200;
+
+// Views instantiated since the start of the application, ViewExtras excluded
+static size_t countInstantiatedViews()
+{
+    size_t total = 0;
+
+    for (brls::ViewPoolClassStats& stats : brls::ViewPool::getStats())
+    {
+        if (strcmp(stats.name, "ViewExtras") != 0)
+            total += stats.total;
+    }
+
+    return total;
+}
+
+static void runBenchmark(brls::XMLTemplate::Source source, const char* name)
+{
+    size_t views    = 0;
+    brls::Time time = 0;
+
+    for (const char* layout : LAYOUTS)
+    {
+        std::string path = std::string(BRLS_RESOURCES) + layout;
+
+        for (int i = 0; i < ITERATIONS; i++)
+        {
+            size_t viewsBefore    = countInstantiatedViews();
+            brls::Time timeBefore = brls::getCPUTimeUsec();
+
+            // Load the layout every time, that's what the compiled archive saves
+            std::unique_ptr<brls::XMLTemplate> xmlTemplate = brls::XMLTemplate::loadFile(path, source);
+
+            if (!xmlTemplate)
+            {
+                brls::Logger::warning("Benchmark: cannot load {} from the {} source, skipping it", layout, name);
+                break;
+            }
+
+            brls::View* view = brls::View::createFromXMLElement(xmlTemplate->getRoot());
+
+            time += brls::getCPUTimeUsec() - timeBefore;
+            views += countInstantiatedViews() - viewsBefore;
+
+            delete view; // views must go before their template
+        }
+    }
+
+    if (time == 0)
+    {
+        brls::Logger::info("Benchmark: {}: nothing was inflated", name);
+        return;
+    }
+
+    brls::Logger::info("Benchmark: {}: {} views in {} ms, {} views/sec", name, views, time / 1000, views * 1000000 / time);
+}
+
+void runInflateBenchmark()
+{
+    runBenchmark(brls::XMLTemplate::Source::XML, "XML");
+    runBenchmark(brls::XMLTemplate::Source::COMPILED, "compiled");
+}
@@ -25,13 +25,20 @@
 
 #include <borealis.hpp>
 #include <string>
+#include <unordered_map>
 
+#include "animation_benchmark.hpp"
+#include "async_benchmark.hpp"
 #include "captioned_image.hpp"
 #include "components_tab.hpp"
+#include "coroutine_benchmark.hpp"
+#include "inflate_benchmark.hpp"
 #include "main_activity.hpp"
 #include "pokemon_view.hpp"
 #include "recycling_list_tab.hpp"
 #include "settings_tab.hpp"
+#include "theme_benchmark.hpp"
+#include "view_benchmark.hpp"
 
 using namespace brls::literals; // for _i18n
 
@@ -74,8 +81,28 @@ int main(int argc, char* argv[])
     brls::getStyle().addMetric("about/padding_sides", 75);
     brls::getStyle().addMetric("about/description_margin", 50);
 
-    // Create and push the main activity to the stack
-    brls::Application::pushActivity(new MainActivity());
+    // Run a benchmark instead of the demo if one is given
+    static const std::unordered_map<std::string, void (*)()> benchmarks = {
+        { "--benchmark-inflate", runInflateBenchmark }, // inflate throughput
+        { "--benchmark-async", runAsyncBenchmark }, // worker pool latency and throughput
+        { "--benchmark-coroutines", runCoroutineBenchmark }, // coroutines resume time
+        { "--benchmark-animations", runAnimationBenchmark }, // animation engine update time
+        { "--benchmark-theme", runThemeBenchmark }, // theme lookups
+        { "--benchmark-views", runViewBenchmark }, // frame() traversal of many views
+    };
+
+    if (argc > 1 && benchmarks.count(argv[1]) > 0)
+    {
+        benchmarks.at(argv[1])();
+
+        // Exit through the main loop to shut the library down
+        brls::Application::quit();
+    }
+    else
+    {
+        // Create and push the main activity to the stack
+        brls::Application::pushActivity(new MainActivity());
+    }
 
     // Run the app
     while (brls::Application::mainLoop())
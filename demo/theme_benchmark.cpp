@@ -0,0 +1,58 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "theme_benchmark.hpp"
+
+#include <strings.h>
+
+#include <borealis.hpp>
+#include <cstdlib>
+#include <string>
+
+static constexpr int LOOKUPS = 1000000;
+
+// What getTheme() did before the theme was cached: ask the platform
+// for the variant, which read the environment, then look the color up by name
+static brls::Theme resolveTheme()
+{
+    char* themeEnv = getenv("BOREALIS_THEME");
+    if (themeEnv != nullptr && !strcasecmp(themeEnv, "DARK"))
+        return brls::getDarkTheme();
+    else
+        return brls::getLightTheme();
+}
+
+void runThemeBenchmark()
+{
+    std::string name = "brls/text";
+    float checksum   = 0.0f; // keeps the lookups from being optimized out
+
+    brls::Time start = brls::getCPUTimeUsec();
+
+    for (int i = 0; i < LOOKUPS; i++)
+        checksum += resolveTheme()[name].r;
+
+    brls::Time resolved = brls::getCPUTimeUsec() - start;
+
+    start = brls::getCPUTimeUsec();
+
+    for (int i = 0; i < LOOKUPS; i++)
+        checksum += brls::Application::getTheme()["brls/text"].r;
+
+    brls::Time cached = brls::getCPUTimeUsec() - start;
+
+    brls::Logger::info("Benchmark: {} theme lookups: {} us resolving the theme every time, {} us with the cached theme (checksum {})", LOOKUPS, resolved, cached, checksum);
+}
@@ -0,0 +1,23 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+// Looks up "brls/text" 1M times, resolving the theme variant from the
+// environment on every call like getTheme() used to, then from the cached
+// theme, and logs the time taken by both.
+// Run the demo with --benchmark-theme to use it.
+void runThemeBenchmark();
@@ -0,0 +1,132 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "view_benchmark.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <borealis.hpp>
+#include <cstring>
+
+static constexpr int BRANCHES = 100;
+static constexpr int LEAVES   = 49; // per branch, 5,000 views with the branches
+static constexpr int FRAMES   = 200;
+
+#ifdef __linux__
+// Hardware cache misses of the calling thread, -1 if the counter is not available
+static int openCacheMissesCounter()
+{
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof(attr);
+    attr.config         = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+static size_t getLiveExtras()
+{
+    for (brls::ViewPoolClassStats& stats : brls::ViewPool::getStats())
+    {
+        if (strcmp(stats.name, "ViewExtras") == 0)
+            return stats.live;
+    }
+
+    return 0;
+}
+
+void runViewBenchmark()
+{
+    size_t extrasBefore = getLiveExtras();
+
+    brls::Box* root = new brls::Box();
+    size_t views    = 1;
+
+    for (int i = 0; i < BRANCHES; i++)
+    {
+        brls::Box* branch = new brls::Box();
+
+        for (int j = 0; j < LEAVES; j++)
+            branch->addView(new brls::Box());
+
+        root->addView(branch);
+        views += LEAVES + 1;
+    }
+
+    NVGcontext* vg = brls::Application::getNVGContext();
+
+    brls::FrameContext ctx;
+    ctx.vg         = vg;
+    ctx.pixelRatio = 1.0f;
+    ctx.theme      = brls::Application::getTheme();
+
+    auto frame = [&] {
+        nvgBeginFrame(vg, brls::Application::contentWidth, brls::Application::contentHeight, ctx.pixelRatio);
+        root->frame(&ctx);
+        nvgCancelFrame(vg);
+    };
+
+    frame(); // warm up
+
+#ifdef __linux__
+    int counter = openCacheMissesCounter();
+    if (counter >= 0)
+    {
+        ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+
+    brls::Time start = brls::getCPUTimeUsec();
+
+    for (int i = 0; i < FRAMES; i++)
+        frame();
+
+    brls::Time time = brls::getCPUTimeUsec() - start;
+
+    brls::Logger::info("Benchmark: {} views, sizeof(View) = {}, sizeof(Box) = {}, sizeof(ViewExtras) = {}, {} extras allocated", views, sizeof(brls::View), sizeof(brls::Box), sizeof(brls::ViewExtras), getLiveExtras() - extrasBefore);
+    brls::Logger::info("Benchmark: frame() of {} views in {} us on average", views, time / FRAMES);
+
+#ifdef __linux__
+    long long misses = 0;
+    if (counter >= 0)
+    {
+        ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+
+        if (read(counter, &misses, sizeof(misses)) == sizeof(misses))
+            brls::Logger::info("Benchmark: {} cache misses per frame", misses / FRAMES);
+
+        close(counter);
+    }
+    else
+    {
+        brls::Logger::warning("Benchmark: cache misses counter not available, see /proc/sys/kernel/perf_event_paranoid");
+    }
+#endif
+
+    delete root;
+}
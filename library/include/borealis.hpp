@@ -26,15 +26,20 @@
 #include <borealis/core/audio.hpp>
 #include <borealis/core/bind.hpp>
 #include <borealis/core/box.hpp>
+#include <borealis/core/coroutine.hpp>
 #include <borealis/core/event.hpp>
 #include <borealis/core/font.hpp>
 #include <borealis/core/frame_context.hpp>
+#include <borealis/core/future.hpp>
 #include <borealis/core/geometry.hpp>
 #include <borealis/core/gesture.hpp>
 #include <borealis/core/i18n.hpp>
 #include <borealis/core/input.hpp>
 #include <borealis/core/logger.hpp>
 #include <borealis/core/platform.hpp>
+#include <borealis/core/platform_status.hpp>
+#include <borealis/core/profiler.hpp>
+#include <borealis/core/scheduler.hpp>
 #include <borealis/core/style.hpp>
 #include <borealis/core/task.hpp>
 #include <borealis/core/theme.hpp>
@@ -46,6 +51,7 @@
 
 // Views
 #include <borealis/views/applet_frame.hpp>
+#include <borealis/views/async_layout.hpp>
 #include <borealis/views/button.hpp>
 #include <borealis/views/dialog.hpp>
 #include <borealis/views/dropdown.hpp>
@@ -27,6 +27,10 @@ namespace brls
     brls::View* createContentView() override { return brls::View::createFromXMLFile(x); }
 #define CONTENT_FROM_XML_STR(x) \
     brls::View* createContentView() override { return brls::View::createFromXMLString(x); }
+#define CONTENT_FROM_XML_RES_ASYNC(x) \
+    brls::View* createContentView() override { return brls::AsyncLayout::createFromXMLResource(x); }
+#define CONTENT_FROM_XML_FILE_ASYNC(x) \
+    brls::View* createContentView() override { return brls::AsyncLayout::createFromXMLFile(x); }
 
 // An activity is a "screen" of your app in which the library adds
 // the UI components. The app is made of a stack of activities, each activity
@@ -63,6 +67,10 @@ class Activity
      *
      * The onContentAvailable() method will be called once the content has been created, so that
      * you can get the references to the activity views (by id).
+     *
+     * The CONTENT_FROM_XML_RES_ASYNC and CONTENT_FROM_XML_FILE_ASYNC macros inflate the XML
+     * without blocking the main thread, see AsyncLayout. onContentAvailable() is then called
+     * once the content is inflated.
      */
     virtual View* createContentView();
 
@@ -152,6 +160,8 @@ class Activity
 
     void onWindowSizeChanged();
 
+    void onThemeChanged();
+
     View* getDefaultFocus();
 
     void setAlpha(float alpha);
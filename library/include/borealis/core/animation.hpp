@@ -19,12 +19,15 @@
 #include <tweeny.h>
 
 #include <borealis/core/time.hpp>
+#include <vector>
 
 namespace brls
 {
 
 using EasingFunction = tweeny::easing::enumerated;
 
+class AnimationEngine;
+
 // An animatable is a float which value can be animated from an initial value to a target value,
 // during a given amount of time. An easing function can also be specified.
 //
@@ -37,7 +40,11 @@ using EasingFunction = tweeny::easing::enumerated;
 //
 // An animatable has overloads for float conversion, comparison (==) and assignment operator (=) to allow
 // basic usage as a simple float. Assignment operator is a shortcut to the reset() method.
-class Animatable : public FiniteTicking
+//
+// The animatable only holds the steps of the animation: running animations are stored and
+// evaluated all at once by the animation engine, grouped by easing function, which writes
+// the new value back every frame.
+class Animatable
 {
   public:
     /**
@@ -45,11 +52,29 @@ class Animatable : public FiniteTicking
      */
     Animatable(float value = 0.0f);
 
+    Animatable(const Animatable&) = delete;
+    Animatable& operator=(const Animatable&) = delete;
+
+    ~Animatable();
+
     /**
      * Returns the current animatable value.
      */
     float getValue();
 
+    /**
+     * Starts the animation. If the animation is already running,
+     * this method will have no effect. A stopped animation resumes
+     * from where it was stopped.
+     */
+    void start();
+
+    /**
+     * Stops the animation if it was running, and executes the end callback.
+     * The value will stay where it's at.
+     */
+    void stop();
+
     /**
      * Stops and resets the animation, going back to the given initial value.
      * All steps are removed.
@@ -66,6 +91,12 @@ class Animatable : public FiniteTicking
      */
     void reset();
 
+    /**
+     * Goes back to the beginning of the animation without removing the steps.
+     * Does not start or stop it.
+     */
+    void rewind();
+
     /**
      * Adds an animation step to the target value, lasting the specified duration in milliseconds.
      *
@@ -73,7 +104,6 @@ class Animatable : public FiniteTicking
      * Easing function is optional, default is EasingFunction::linear.
      *
      * Duration is int32_t due to internal limitations, so a step cannot last for longer than 2 147 483 647ms.
-     * The sum of the duration of all steps cannot exceed 71582min.
      */
     void addStep(float targetValue, int32_t duration, EasingFunction easing = EasingFunction::linear);
 
@@ -82,20 +112,62 @@ class Animatable : public FiniteTicking
      */
     float getProgress();
 
+    /**
+     * Sets a callback to be executed when the animation finishes.
+     * The callback argument will be set to true if the animation stopped
+     * on its own, false if it was stopped early by the user.
+     */
+    void setEndCallback(TickingEndCallback endCallback);
+
+    /**
+     * Sets a callback to be executed at every frame
+     * until the animation finishes.
+     *
+     * The last animation frame will execute the tick callback
+     * then the end callback.
+     */
+    void setTickCallback(TickingTickCallback tickCallback);
+
+    /**
+     * Returns true if the animation is currently running.
+     */
+    bool isRunning();
+
     operator float() const;
     operator float();
     void operator=(const float value);
     bool operator==(const float value);
 
-  protected:
-    bool onUpdate(Time delta) override;
+  private:
+    friend class AnimationEngine;
 
-    void onReset() override;
-    void onRewind() override;
+    struct Step
+    {
+        float target;
+        int32_t duration;
+        EasingFunction easing;
+    };
+
+    static constexpr size_t NO_SLOT = (size_t)-1;
 
-  private:
     float currentValue = 0.0f;
-    tweeny::tween<float> tween;
+    float initialValue = 0.0f; // value at the beginning of the first step
+
+    std::vector<Step> steps;
+    size_t currentStep = 0;
+    float stepElapsed  = 0.0f; // elapsed time in the current step while stopped, in ms
+
+    size_t group      = 0; // easing function group in the animation engine while running
+    size_t slot       = NO_SLOT; // index in the group while running
+    bool lastStepDone = false; // finished this frame, stopped once its tick callback ran
+
+    TickingEndCallback endCallback   = nullptr;
+    TickingTickCallback tickCallback = nullptr;
+
+    void stop(bool finished);
+
+    // Returns the value the current step starts from
+    float getStepStart();
 };
 
 void updateHighlightAnimation();
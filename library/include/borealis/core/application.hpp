@@ -27,11 +27,14 @@
 #include <borealis/core/frame_context.hpp>
 #include <borealis/core/logger.hpp>
 #include <borealis/core/platform.hpp>
+#include <borealis/core/startup.hpp>
 #include <borealis/core/style.hpp>
 #include <borealis/core/theme.hpp>
 #include <borealis/core/view.hpp>
 #include <borealis/views/debug_layer.hpp>
 #include <borealis/views/label.hpp>
+#include <mutex>
+#include <set>
 #include <unordered_map>
 #include <vector>
 
@@ -114,18 +117,36 @@ class Application
         return brls::getStyle();
     }
 
-    static Theme getTheme();
+    /**
+     * Returns the active theme. The theme is resolved once
+     * when the application starts, then only changes
+     * with setThemeVariant().
+     */
+    static const Theme& getTheme();
     static ThemeVariant getThemeVariant();
 
+    /**
+     * Switches the active theme. Colors applied from the theme
+     * in XML are applied again, and the theme change event is fired
+     * so that views caching other colors can update them.
+     */
+    static void setThemeVariant(ThemeVariant variant);
+
     /**
      * Loads a font from a given file and stores it in the font stash.
      * Returns true if the operation succeeded.
+     *
+     * Before the window is created, the font is registered once it is
+     * and true is returned right away.
      */
     static bool loadFontFromFile(std::string fontName, std::string filePath);
 
     /**
      * Loads a font from a given memory buffer and stores it in the font stash.
      * Returns true if the operation succeeded.
+     *
+     * Before the window is created, the font is registered once it is
+     * and true is returned right away.
      */
     static bool loadFontFromMemory(std::string fontName, void* data, size_t size, bool freeData);
 
@@ -135,6 +156,12 @@ class Application
      */
     static int getFont(std::string fontName);
 
+    /**
+     * Returns the startup milestone reached once the window
+     * is created, for the startup tasks needing the graphics context.
+     */
+    static StartupTaskId getWindowMilestone();
+
     static void notify(std::string text);
 
     static void onControllerButtonPressed(enum ControllerButton button, bool repeating);
@@ -183,6 +210,7 @@ class Application
     static VoidEvent* getGlobalHintsUpdateEvent();
     static Event<InputType>* getGlobalInputTypeChangeEvent();
     static VoidEvent* getRunLoopEvent();
+    static Event<ThemeVariant>* getThemeChangeEvent();
 
     static View* getCurrentFocus();
 
@@ -202,6 +230,15 @@ class Application
     static bool XMLViewsRegisterContains(std::string name);
     static XMLViewCreator getXMLViewCreator(std::string name);
 
+    /**
+     * Returns the creator registered for the given XML node name, or nullptr
+     * if there is none. The pointer stays valid, and follows the creator if
+     * the name is registered again.
+     *
+     * Can be called from any thread, the creator must only be called from the main thread.
+     */
+    static const XMLViewCreator* findXMLViewCreator(const std::string& name);
+
     /**
      * Returns the current system locale.
      */
@@ -253,6 +290,9 @@ class Application
     inline static std::string title;
 
     inline static FontStash fontStash;
+    inline static std::set<std::string> fontFallbacks; // fonts already added as fallbacks of the regular font
+
+    inline static StartupTaskId windowMilestone = 0;
 
     inline static std::vector<Activity*> activitiesStack;
     inline static std::vector<View*> focusStack;
@@ -285,8 +325,13 @@ class Application
     inline static VoidEvent globalHintsUpdateEvent;
     inline static Event<InputType> globalInputTypeChangeEvent;
     inline static VoidEvent runLoopEvent;
+    inline static Event<ThemeVariant> themeChangeEvent;
+
+    inline static ThemeVariant themeVariant = ThemeVariant::LIGHT;
+    inline static Theme theme               = nullptr;
 
     inline static std::unordered_map<std::string, XMLViewCreator> xmlViewsRegister;
+    inline static std::mutex xmlViewsRegisterMutex; // templates are compiled by the workers too
 
     static void navigate(FocusDirection direction, bool repeating);
 
@@ -305,6 +350,12 @@ class Application
 
     static void registerBuiltInXMLViews();
 
+    // Adds the loaded icons fonts as fallbacks of the regular font, fonts can be loaded in any order
+    static void updateFontFallbacks();
+
+    // Fonts loaded before the window is created are deferred until it is
+    static bool isWindowCreated();
+
     static ActionIdentifier registerFPSToggleAction(Activity* activity);
 
     inline static DebugLayer* debugLayer = nullptr;
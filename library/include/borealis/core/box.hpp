@@ -60,6 +60,8 @@ enum class Direction
 // Generic FlexBox layout
 class Box : public View
 {
+    BRLS_POOLED_CLASS(Box)
+
   public:
     Box(Axis flexDirection);
     Box();
@@ -72,13 +74,15 @@ class Box : public View
     void willAppear(bool resetState) override;
     void willDisappear(bool resetState) override;
     void onWindowSizeChanged() override;
+    void onThemeChanged() override;
     void onFocusGained() override;
     void onFocusLost() override;
     void onParentFocusGained(View* focusedView) override;
     void onParentFocusLost(View* focusedView) override;
-    bool applyXMLAttribute(std::string name, std::string value) override;
+    bool applyXMLAttributeValue(const std::string& name, const XMLValue& value) override;
 
     static View* create();
+    static const XMLAttributeTable* getXMLAttributeTable();
 
     virtual View* getParentNavigationDecision(View* from, View* newFocus, FocusDirection direction);
 
@@ -211,8 +215,6 @@ class Box : public View
      */
     virtual void onChildFocusLost(View* directChild, View* focusedView);
 
-    View* getView(std::string id) override;
-
     void setLastFocusedView(View* view)
     {
         this->lastFocusedView = view;
@@ -237,8 +239,14 @@ class Box : public View
      *
      * Each child node in the root brls::Box will be treated as a view and added
      * as a child of the Box.
+     *
+     * By default the parsed XML is owned by the Box and freed along with it.
+     * Set cache to true for constant layouts inflated many times: the parsed XML
+     * is then cached for the whole application lifetime, keyed by its content,
+     * so that inflating another Box with it doesn't parse anything.
+     * The cache is never evicted, don't use it for XML generated at runtime.
      */
-    void inflateFromXMLString(std::string xml);
+    void inflateFromXMLString(std::string xml, bool cache = false);
 
     /**
      * Inflates the Box with the given XML element.
@@ -286,6 +294,8 @@ class Box : public View
 // all the next views in its box to the right (or to the bottom)
 class Padding : public View
 {
+    BRLS_POOLED_CLASS(Padding)
+
   public:
     Padding();
 
@@ -0,0 +1,135 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/assets.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+// Archive of the XML layouts compiled at build time by scripts/compile-layouts.py
+#ifndef BRLS_COMPILED_LAYOUTS
+#define BRLS_COMPILED_LAYOUTS BRLS_ASSET("xml/layouts.brlx")
+#endif
+
+namespace brls
+{
+
+// Binary layout of the compiled layouts archive, see scripts/compile-layouts.py
+// Everything is little endian, and every section is 8 bytes aligned.
+namespace compiled
+{
+
+    constexpr char MAGIC[4]           = { 'B', 'R', 'L', 'X' };
+    constexpr uint32_t VERSION        = 1;
+    constexpr uint32_t NONE           = 0xFFFFFFFF; // missing element index
+    constexpr uint8_t TYPE_UNPARSED   = 0xFF; // left for the library to parse from the raw value
+
+    struct Header
+    {
+        char magic[4];
+        uint32_t version;
+
+        uint32_t stringsCount;
+        uint32_t stringsOffset; // String[stringsCount], then the null terminated characters
+
+        uint32_t layoutsCount;
+        uint32_t layoutsOffset; // Layout[layoutsCount]
+
+        uint32_t elementsCount;
+        uint32_t elementsOffset; // Element[elementsCount]
+
+        uint32_t attributesCount;
+        uint32_t attributesOffset; // Attribute[attributesCount]
+    };
+
+    // Interned string, given by its index
+    struct String
+    {
+        uint64_t hash; // hashKey() of the string
+        uint32_t offset; // from the start of the archive
+        uint32_t length;
+    };
+
+    struct Layout
+    {
+        uint32_t path; // relative to the resources directory, "xml/tabs/settings.xml"
+        uint32_t root; // element
+    };
+
+    struct Element
+    {
+        uint32_t tag;
+        uint32_t firstAttribute;
+        uint32_t attributesCount;
+        uint32_t firstChild; // or NONE
+        uint32_t nextSibling; // or NONE
+    };
+
+    // Attribute value, parsed the same way as XMLValue does
+    struct Attribute
+    {
+        uint32_t name;
+        uint32_t raw;
+        uint32_t text; // translation name if i18n, path relative to the resources if RES, key if STYLE or THEME, raw otherwise
+
+        uint8_t type; // XMLValueType, or TYPE_UNPARSED
+        uint8_t i18n;
+        uint8_t boolean;
+        uint8_t padding;
+
+        float number;
+        float color[4]; // r, g, b, a
+    };
+
+} // namespace compiled
+
+// Compiled layouts archive, memory mapped when the platform allows it
+//
+// The archive is loaded once, the first time a layout is looked up. If it's
+// missing or was built for another version of the library, every layout
+// is loaded from its XML file instead.
+class CompiledLayouts
+{
+  public:
+    /**
+     * Returns the compiled root element of the layout at the given path
+     * (full path, including the resources directory), or nullptr if the
+     * layout isn't in the archive.
+     */
+    static const compiled::Element* findLayout(const std::string& path);
+
+    static const compiled::Element* getElement(uint32_t index);
+    static const compiled::Attribute* getAttribute(uint32_t index);
+    static const compiled::String* getString(uint32_t index);
+    static const char* getStringValue(uint32_t index);
+
+  private:
+    inline static bool loaded     = false;
+    inline static const uint8_t* data = nullptr;
+    inline static size_t size     = 0;
+
+    inline static const compiled::Header* header = nullptr;
+    inline static std::unordered_map<std::string, uint32_t> layouts; // path -> root element
+
+    static void load();
+    static bool map(const char* path);
+    static bool validate();
+};
+
+} // namespace brls
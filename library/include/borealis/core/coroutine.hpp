@@ -0,0 +1,256 @@
+/*
+    Copyright 2021 XITRIX
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+// Coroutines need C++20, this header is empty for older standards
+// Build with meson configure -Dcoroutines=true, or make COROUTINES=1, to enable them
+// BRLS_COROUTINES is defined when they are available
+#if __cplusplus >= 202002L && __has_include(<coroutine>)
+
+#define BRLS_COROUTINES
+
+#include <borealis/core/logger.hpp>
+#include <borealis/core/thread.hpp>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <new>
+
+namespace brls
+{
+
+namespace internal
+{
+
+    // Pool of coroutine frames, sorted by size classes
+    // Freed frames are kept for the next coroutines of the same size class,
+    // so that a coroutine started every frame doesn't hit the heap
+    class CoroutineFramePool
+    {
+      public:
+        static void* allocate(size_t size)
+        {
+            size_t sizeClass = getSizeClass(size);
+            if (sizeClass >= SIZE_CLASSES)
+                return ::operator new(size);
+
+            {
+                std::lock_guard<std::mutex> guard(mutex);
+                if (FreeFrame* frame = freeFrames[sizeClass])
+                {
+                    freeFrames[sizeClass] = frame->next;
+                    return frame;
+                }
+            }
+
+            return ::operator new((sizeClass + 1) * GRANULARITY);
+        }
+
+        static void deallocate(void* ptr, size_t size)
+        {
+            size_t sizeClass = getSizeClass(size);
+            if (sizeClass >= SIZE_CLASSES)
+            {
+                ::operator delete(ptr);
+                return;
+            }
+
+            std::lock_guard<std::mutex> guard(mutex);
+            FreeFrame* frame      = static_cast<FreeFrame*>(ptr);
+            frame->next           = freeFrames[sizeClass];
+            freeFrames[sizeClass] = frame;
+        }
+
+      private:
+        static constexpr size_t GRANULARITY  = 64;
+        static constexpr size_t SIZE_CLASSES = 32; // frames bigger than 2KB are not pooled
+
+        struct FreeFrame
+        {
+            FreeFrame* next;
+        };
+
+        inline static std::mutex mutex;
+        inline static FreeFrame* freeFrames[SIZE_CLASSES] = {};
+
+        static size_t getSizeClass(size_t size)
+        {
+            return (size - 1) / GRANULARITY;
+        }
+    };
+
+    // Resumes the coroutine on the main thread, before the next frame is drawn
+    struct MainThreadAwaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) const
+        {
+            Threading::sync([handle] { handle.resume(); });
+        }
+
+        void await_resume() const noexcept { }
+    };
+
+    // Resumes the coroutine on a worker thread
+    struct BackgroundAwaiter
+    {
+        TaskPriority priority;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) const
+        {
+            Threading::async([handle] { handle.resume(); }, priority);
+        }
+
+        void await_resume() const noexcept { }
+    };
+
+    // Resumes the coroutine on the main thread once the delay is over
+    struct DelayAwaiter
+    {
+        long milliseconds;
+
+        bool await_ready() const noexcept
+        {
+            return milliseconds <= 0;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) const
+        {
+            Threading::delay(milliseconds, [handle] { handle.resume(); });
+        }
+
+        void await_resume() const noexcept { }
+    };
+
+} // namespace internal
+
+// Fire and forget coroutine running UI flows
+//
+// A UiTask starts on the main thread, with the next iteration of
+// the main loop, then runs until it finishes. Use the awaitables below
+// to hop between threads or to spread work over multiple frames:
+//
+//   brls::UiTask scanDirectory(Label* label, std::string path)
+//   {
+//       co_await brls::background();
+//       std::vector<std::string> files = listFiles(path);
+//
+//       co_await brls::mainThread();
+//       for (std::string& file : files)
+//       {
+//           label->setText(file);
+//           co_await brls::nextFrame();
+//       }
+//   }
+//
+// Views are not retained by the coroutine, the caller has to make
+// sure they live until the coroutine resumes on the main thread.
+class UiTask
+{
+  public:
+    struct promise_type
+    {
+        UiTask get_return_object() noexcept
+        {
+            return UiTask();
+        }
+
+        internal::MainThreadAwaiter initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void return_void() const noexcept { }
+
+        void unhandled_exception() const noexcept
+        {
+            try
+            {
+                std::rethrow_exception(std::current_exception());
+            }
+            catch (const std::exception& e)
+            {
+                Logger::error("Unhandled exception in UiTask: {}", e.what());
+            }
+            catch (...)
+            {
+                Logger::error("Unhandled exception in UiTask");
+            }
+        }
+
+        static void* operator new(size_t size)
+        {
+            return internal::CoroutineFramePool::allocate(size);
+        }
+
+        static void operator delete(void* ptr, size_t size)
+        {
+            internal::CoroutineFramePool::deallocate(ptr, size);
+        }
+    };
+};
+
+/**
+ * Resumes the coroutine on a worker thread.
+ */
+inline internal::BackgroundAwaiter background(TaskPriority priority = TaskPriority::NORMAL)
+{
+    return internal::BackgroundAwaiter { priority };
+}
+
+/**
+ * Resumes the coroutine on the main thread, before the next frame is drawn.
+ */
+inline internal::MainThreadAwaiter mainThread()
+{
+    return internal::MainThreadAwaiter {};
+}
+
+/**
+ * Suspends the coroutine until the next frame, resuming it on the main thread.
+ * Use it to slice long operations across multiple frames.
+ */
+inline internal::MainThreadAwaiter nextFrame()
+{
+    return internal::MainThreadAwaiter {};
+}
+
+/**
+ * Resumes the coroutine on the main thread after the given amount of milliseconds.
+ */
+inline internal::DelayAwaiter delay(long milliseconds)
+{
+    return internal::DelayAwaiter { milliseconds };
+}
+
+} // namespace brls
+
+#endif
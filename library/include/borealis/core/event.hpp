@@ -16,13 +16,110 @@
 
 #pragma once
 
-#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
-#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace brls
 {
 
+// Subscribers of an event, shared with the subscriptions
+class EventSlotsBase
+{
+  public:
+    virtual ~EventSlotsBase() = default;
+
+    virtual void remove(uint32_t index, uint32_t generation)         = 0;
+    virtual bool contains(uint32_t index, uint32_t generation) const = 0;
+};
+
+// Handle to a subscription of an event, given by Event::subscribe()
+//
+// Handles are generation checked: unsubscribing twice, unsubscribing after
+// the slot was given to another subscriber or after the event is gone does nothing.
+class EventSubscription
+{
+  public:
+    EventSubscription() = default;
+
+    /**
+     * Removes the subscriber from its event, if both are still there.
+     */
+    void unsubscribe()
+    {
+        if (std::shared_ptr<EventSlotsBase> slots = this->slots.lock())
+            slots->remove(this->index, this->generation);
+
+        this->slots.reset();
+    }
+
+    /**
+     * Returns true if the subscriber is still subscribed to its event.
+     */
+    bool isSubscribed() const
+    {
+        std::shared_ptr<EventSlotsBase> slots = this->slots.lock();
+        return slots && slots->contains(this->index, this->generation);
+    }
+
+  private:
+    std::weak_ptr<EventSlotsBase> slots;
+    uint32_t index      = 0;
+    uint32_t generation = 0;
+
+    template <typename... Ts>
+    friend class Event;
+};
+
+// Subscription removed when destroyed, to tie a subscriber to the lifetime of its owner
+class ScopedSubscription
+{
+  public:
+    ScopedSubscription() = default;
+
+    ScopedSubscription(EventSubscription subscription)
+        : subscription(std::move(subscription))
+    {
+    }
+
+    ScopedSubscription(const ScopedSubscription&) = delete;
+    ScopedSubscription& operator=(const ScopedSubscription&) = delete;
+
+    ScopedSubscription(ScopedSubscription&& other) = default;
+
+    ScopedSubscription& operator=(ScopedSubscription&& other)
+    {
+        if (this != &other)
+        {
+            this->subscription.unsubscribe();
+            this->subscription = std::move(other.subscription);
+        }
+
+        return *this;
+    }
+
+    ~ScopedSubscription()
+    {
+        this->subscription.unsubscribe();
+    }
+
+    void unsubscribe()
+    {
+        this->subscription.unsubscribe();
+    }
+
+    bool isSubscribed() const
+    {
+        return this->subscription.isSubscribed();
+    }
+
+  private:
+    EventSubscription subscription;
+};
+
 // Simple observer pattern implementation
 //
 // Usage:
@@ -32,43 +129,228 @@ namespace brls
 // 4. call fire when you want to fire the events
 //    it wil return true if at least one subscriber exists
 //    for that event
+//
+// Subscribers are stored in a contiguous array of slots, allocated with the
+// first subscriber, and called in place: firing doesn't allocate nor copy them.
+// Subscribers can subscribe, unsubscribe or destroy the event while it fires:
+// new subscribers are only called by the next fire, and removed subscribers
+// are destroyed once the fire is over.
 template <typename... Ts>
 class Event
 {
   public:
     typedef std::function<void(Ts...)> Callback;
-    typedef std::list<Callback> CallbacksList;
-    typedef typename CallbacksList::iterator Subscription;
+    typedef EventSubscription Subscription;
+
+    Event() = default;
+
+    // Copies get their own subscribers, the subscriptions stay with the original event
+    Event(const Event& other);
+    Event& operator=(const Event& other);
+
+    Event(Event&& other) = default;
+    Event& operator=(Event&& other) = default;
 
     Subscription subscribe(Callback cb);
     void unsubscribe(Subscription subscription);
     bool fire(Ts... args);
 
   private:
-    CallbacksList callbacks;
+    struct Slot
+    {
+        Callback callback;
+        uint32_t generation = 1;
+        bool active         = false;
+    };
+
+    class Slots : public EventSlotsBase
+    {
+      public:
+        std::vector<Slot> slots;
+        std::vector<Slot> added; // subscribed while firing, appended to the slots once it's over
+        std::vector<uint32_t> freeSlots;
+
+        size_t count          = 0; // active subscribers
+        unsigned firing       = 0; // nested fires
+        bool removedWhileFire = false;
+
+        Slot* find(uint32_t index)
+        {
+            if (index < this->slots.size())
+                return &this->slots[index];
+            else if (index - this->slots.size() < this->added.size())
+                return &this->added[index - this->slots.size()];
+
+            return nullptr;
+        }
+
+        void remove(uint32_t index, uint32_t generation) override
+        {
+            Slot* slot = this->find(index);
+            if (!slot || !slot->active || slot->generation != generation)
+                return;
+
+            slot->active = false;
+            this->count--;
+
+            // The callback may be running, only destroy it once the fire is over
+            if (this->firing > 0)
+            {
+                this->removedWhileFire = true;
+                return;
+            }
+
+            this->release(index);
+        }
+
+        bool contains(uint32_t index, uint32_t generation) const override
+        {
+            Slot* slot = const_cast<Slots*>(this)->find(index);
+            return slot && slot->active && slot->generation == generation;
+        }
+
+        void release(uint32_t index)
+        {
+            Slot& slot    = this->slots[index];
+            slot.callback = nullptr;
+            slot.generation++;
+            this->freeSlots.push_back(index);
+        }
+
+        // Called once the outermost fire is over
+        void flush()
+        {
+            for (Slot& slot : this->added)
+                this->slots.push_back(std::move(slot));
+
+            this->added.clear();
+
+            if (!this->removedWhileFire)
+                return;
+
+            for (uint32_t i = 0; i < this->slots.size(); i++)
+            {
+                if (!this->slots[i].active && this->slots[i].callback)
+                    this->release(i);
+            }
+
+            this->removedWhileFire = false;
+        }
+    };
+
+    // Ends the fire even if a subscriber throws
+    struct FireGuard
+    {
+        Slots* slots;
+
+        ~FireGuard()
+        {
+            if (--this->slots->firing == 0)
+                this->slots->flush();
+        }
+    };
+
+    std::shared_ptr<Slots> slots;
 };
 
+template <typename... Ts>
+Event<Ts...>::Event(const Event<Ts...>& other)
+{
+    *this = other;
+}
+
+template <typename... Ts>
+Event<Ts...>& Event<Ts...>::operator=(const Event<Ts...>& other)
+{
+    if (this == &other)
+        return *this;
+
+    this->slots.reset();
+
+    if (other.slots)
+    {
+        for (const std::vector<Slot>* slots : { &other.slots->slots, &other.slots->added })
+        {
+            for (const Slot& slot : *slots)
+            {
+                if (slot.active)
+                    this->subscribe(slot.callback);
+            }
+        }
+    }
+
+    return *this;
+}
+
 template <typename... Ts>
 typename Event<Ts...>::Subscription Event<Ts...>::subscribe(Event<Ts...>::Callback cb)
 {
-    this->callbacks.push_back(cb);
-    return --this->callbacks.end();
+    if (!this->slots)
+        this->slots = std::make_shared<Slots>();
+
+    Slots* slots = this->slots.get();
+    uint32_t index;
+    Slot* slot;
+
+    if (slots->firing > 0)
+    {
+        // The slots cannot move while firing
+        index = slots->slots.size() + slots->added.size();
+        slot  = &slots->added.emplace_back();
+    }
+    else if (!slots->freeSlots.empty())
+    {
+        index = slots->freeSlots.back();
+        slot  = &slots->slots[index];
+        slots->freeSlots.pop_back();
+    }
+    else
+    {
+        index = slots->slots.size();
+        slot  = &slots->slots.emplace_back();
+    }
+
+    slot->callback = std::move(cb);
+    slot->active   = true;
+    slots->count++;
+
+    Subscription subscription;
+    subscription.slots      = this->slots;
+    subscription.index      = index;
+    subscription.generation = slot->generation;
+    return subscription;
 }
 
 template <typename... Ts>
 void Event<Ts...>::unsubscribe(Event<Ts...>::Subscription subscription)
 {
-    if (this->callbacks.size() > 0)
-        this->callbacks.erase(subscription);
+    // Only unsubscribe subscribers of this event
+    if (this->slots && subscription.slots.lock() == this->slots)
+        subscription.unsubscribe();
 }
 
 template <typename... Ts>
 bool Event<Ts...>::fire(Ts... args)
 {
-    for (Callback cb : this->callbacks)
-        cb(args...);
+    if (!this->slots || this->slots->count == 0)
+        return false;
+
+    // Keeps the slots alive if a subscriber destroys the event
+    std::shared_ptr<Slots> slots = this->slots;
+
+    slots->firing++;
+    FireGuard guard = { slots.get() };
+
+    // Subscribers added while firing go to the added slots: the array doesn't move
+    size_t size = slots->slots.size();
+    for (size_t i = 0; i < size; i++)
+    {
+        Slot& slot = slots->slots[i];
+        if (slot.active)
+            slot.callback(args...);
+    }
 
-    return !this->callbacks.empty();
+    return true;
 }
 
 }; // namespace brls
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <unordered_map>
 
@@ -37,11 +38,15 @@ class FontLoader
   public:
     virtual ~FontLoader() { }
     /**
-     * Called once on init to load every font in the font stash.
+     * Called once on init, before the window is created, to load every font in the font stash.
      *
-     * The implementation must use the Application::loadFont and
-     * Application::loadFontFromMemory methods to load as much as possible
-     * of the "built-in" fonts defined in the FONT_* constants above.
+     * The implementation should use the loadFontFromFile and loadFontFromMemory
+     * methods below to load as much as possible of the "built-in" fonts defined
+     * in the FONT_* constants above. Fonts are loaded as startup tasks (see brls::Startup):
+     * files are read in the background and fonts are registered once the window is created.
+     *
+     * Fonts loaded with Application::loadFontFromFile and Application::loadFontFromMemory
+     * are registered once the window is created too, but files are read on the main thread.
      */
     virtual void loadFonts() = 0;
 
@@ -49,12 +54,24 @@ class FontLoader
     /**
      * Convenience method to load a font from a file path
      * with some more logging.
+     *
+     * Lazy fonts are not needed to draw the first frame and
+     * keep loading in the background.
+     *
+     * Returns true if the file exists, the font itself is loaded later.
+     */
+    bool loadFontFromFile(std::string fontName, std::string filePath, bool lazy = false);
+
+    /**
+     * Loads a font from memory once the window is created.
+     * The memory must stay valid for the whole application lifetime.
      */
-    bool loadFontFromFile(std::string fontName, std::string filePath);
+    void loadFontFromMemory(std::string fontName, void* address, size_t size, bool lazy = false);
 
     /**
      * Can be called internally to load the Material icons font from resources.
-     * Returns true if the operation succeeds.
+     * Icons are not needed to draw the first frame, the font is loaded lazily.
+     * Returns true if the font file exists.
      */
     bool loadMaterialFromResources();
 };
@@ -0,0 +1,327 @@
+/*
+    Copyright 2021 XITRIX
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <borealis/core/logger.hpp>
+#include <borealis/core/thread.hpp>
+#include <borealis/core/view.hpp>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace brls
+{
+
+// Flag used to cancel a chain of tasks from any thread
+// Copies of a token share the same flag
+class CancellationToken
+{
+  public:
+    CancellationToken()
+        : cancelled(std::make_shared<std::atomic_bool>(false))
+    {
+    }
+
+    void cancel()
+    {
+        *this->cancelled = true;
+    }
+
+    bool isCancelled() const
+    {
+        return *this->cancelled;
+    }
+
+  private:
+    std::shared_ptr<std::atomic_bool> cancelled;
+};
+
+template <typename T>
+class Task;
+
+namespace internal
+{
+
+    // Results of void tasks are stored as an empty value to share the same code
+    struct TaskVoid
+    {
+    };
+
+    template <typename T>
+    using TaskValue = std::conditional_t<std::is_void_v<T>, TaskVoid, T>;
+
+    // Return type of a continuation taking the result of a Task<T>
+    template <typename F, typename T>
+    struct TaskResultOf
+    {
+        using type = std::invoke_result_t<F, T>;
+    };
+
+    template <typename F>
+    struct TaskResultOf<F, void>
+    {
+        using type = std::invoke_result_t<F>;
+    };
+
+    template <typename F, typename T>
+    using TaskResult = typename TaskResultOf<F, T>::type;
+
+    enum class TaskStatus
+    {
+        PENDING,
+        DONE,
+        CANCELLED,
+    };
+
+    // Runs the given job on the right thread, the job argument is false
+    // if the step must be dropped without running (bound view deleted)
+    typedef std::function<void(std::function<void(bool)>)> TaskDispatcher;
+
+    template <typename T>
+    struct TaskState
+    {
+        std::mutex mutex;
+        TaskStatus status = TaskStatus::PENDING;
+        std::optional<TaskValue<T>> value;
+        std::vector<std::function<void()>> continuations;
+        CancellationToken token;
+
+        // Sets the final status then runs the continuations
+        // Status and value never change once set, so continuations can read them without locking
+        void finish(TaskStatus newStatus, std::optional<TaskValue<T>> result = std::nullopt)
+        {
+            std::vector<std::function<void()>> toRun;
+            {
+                std::lock_guard<std::mutex> guard(this->mutex);
+                if (this->status != TaskStatus::PENDING)
+                    return;
+
+                this->value  = std::move(result);
+                this->status = newStatus;
+                toRun.swap(this->continuations);
+            }
+
+            for (auto& continuation : toRun)
+                continuation();
+        }
+
+        // Runs the continuation once the task is finished, right away if it already is
+        void onFinished(std::function<void()> continuation)
+        {
+            {
+                std::lock_guard<std::mutex> guard(this->mutex);
+                if (this->status == TaskStatus::PENDING)
+                {
+                    this->continuations.push_back(std::move(continuation));
+                    return;
+                }
+            }
+
+            continuation();
+        }
+    };
+
+    // Runs one step of a task and finishes its state with the result
+    template <typename R, typename F, typename... Args>
+    void runTaskStep(const std::shared_ptr<TaskState<R>>& state, F& func, Args&... args)
+    {
+        try
+        {
+            if constexpr (std::is_void_v<R>)
+            {
+                func(args...);
+                state->finish(TaskStatus::DONE, TaskVoid());
+            }
+            else
+            {
+                state->finish(TaskStatus::DONE, func(args...));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Logger::error("Task step failed, cancelling the rest of the chain: {}", e.what());
+            state->finish(TaskStatus::CANCELLED);
+        }
+    }
+
+} // namespace internal
+
+// A Task represents the result of an asynchronous operation,
+// to be consumed by continuations running on a worker thread (then)
+// or on the main thread (thenOnMain).
+//
+// Every continuation returns a new Task, so pipelines can be composed:
+//
+//   brls::Task<std::string>::run([] { return fetch(url); })
+//       .then([](std::string data) { return decode(data); })
+//       .thenOnMain(cell, [cell](Image image) { cell->setImage(image); });
+//
+// Continuations share the cancellation token of the task that started the chain.
+// Once cancelled, or if a step throws, the remaining steps are dropped without running.
+template <typename T>
+class Task
+{
+  public:
+    /**
+     * Runs the given function on a worker thread.
+     */
+    template <typename F>
+    static Task<T> run(F func, CancellationToken token = CancellationToken(), TaskPriority priority = TaskPriority::NORMAL)
+    {
+        Task<T> task(token);
+        std::shared_ptr<internal::TaskState<T>> state = task.state;
+
+        Threading::async([state, func]() mutable {
+            if (state->token.isCancelled())
+                state->finish(internal::TaskStatus::CANCELLED);
+            else
+                internal::runTaskStep<T>(state, func);
+        },
+            priority);
+
+        return task;
+    }
+
+    /**
+     * Runs the given function on a worker thread once this task is done,
+     * with the result of this task as argument.
+     */
+    template <typename F>
+    Task<internal::TaskResult<F, T>> then(F func, TaskPriority priority = TaskPriority::NORMAL)
+    {
+        return this->chain(func, [priority](std::function<void(bool)> job) {
+            Threading::async([job] { job(true); }, priority);
+        });
+    }
+
+    /**
+     * Runs the given function on the main thread once this task is done,
+     * with the result of this task as argument.
+     */
+    template <typename F>
+    Task<internal::TaskResult<F, T>> thenOnMain(F func)
+    {
+        return this->chain(func, [](std::function<void(bool)> job) {
+            Threading::sync([job] { job(true); });
+        });
+    }
+
+    /**
+     * Same as thenOnMain(), but the function is dropped without running
+     * if the given view is deleted before this task is done.
+     *
+     * Must be called on the main thread.
+     */
+    template <typename F>
+    Task<internal::TaskResult<F, T>> thenOnMain(View* view, F func)
+    {
+        DeletionToken deletionToken = view->retainDeletionToken();
+
+        return this->chain(func, [deletionToken](std::function<void(bool)> job) {
+            Threading::sync([deletionToken, job] { job(View::releaseDeletionToken(deletionToken)); });
+        });
+    }
+
+    /**
+     * Cancels this task and every task of the chain.
+     * Steps already running will finish, the next ones will not run.
+     */
+    void cancel()
+    {
+        this->state->token.cancel();
+    }
+
+    CancellationToken getCancellationToken() const
+    {
+        return this->state->token;
+    }
+
+    /**
+     * Returns true if the task finished and its result is available.
+     */
+    bool isDone()
+    {
+        std::lock_guard<std::mutex> guard(this->state->mutex);
+        return this->state->status == internal::TaskStatus::DONE;
+    }
+
+    /**
+     * Returns true if the task was cancelled, or if one of the previous steps failed.
+     */
+    bool isCancelled()
+    {
+        std::lock_guard<std::mutex> guard(this->state->mutex);
+        return this->state->status == internal::TaskStatus::CANCELLED;
+    }
+
+  private:
+    template <typename>
+    friend class Task;
+
+    explicit Task(CancellationToken token)
+        : state(std::make_shared<internal::TaskState<T>>())
+    {
+        this->state->token = token;
+    }
+
+    std::shared_ptr<internal::TaskState<T>> state;
+
+    template <typename F>
+    Task<internal::TaskResult<F, T>> chain(F func, internal::TaskDispatcher dispatch)
+    {
+        using R = internal::TaskResult<F, T>;
+
+        Task<R> next(this->state->token);
+        std::shared_ptr<internal::TaskState<T>> parent = this->state;
+        std::shared_ptr<internal::TaskState<R>> child  = next.state;
+
+        parent->onFinished([parent, child, func, dispatch]() {
+            // The job is always dispatched, even when it will not run,
+            // so that the dispatcher can release what it holds on the right thread
+            dispatch([parent, child, func](bool alive) mutable {
+                if (!alive || parent->status != internal::TaskStatus::DONE || child->token.isCancelled())
+                {
+                    child->finish(internal::TaskStatus::CANCELLED);
+                    return;
+                }
+
+                if constexpr (std::is_void_v<T>)
+                    internal::runTaskStep<R>(child, func);
+                else
+                    internal::runTaskStep<R>(child, func, *parent->value);
+            });
+        });
+
+        return next;
+    }
+};
+
+/**
+ * Runs the given function on a worker thread, returning a Task
+ * to chain continuations on. Shortcut for brls::Task<T>::run().
+ */
+template <typename F>
+Task<std::invoke_result_t<F>> runTask(F func, CancellationToken token = CancellationToken(), TaskPriority priority = TaskPriority::NORMAL)
+{
+    return Task<std::invoke_result_t<F>>::run(func, token, priority);
+}
+
+} // namespace brls
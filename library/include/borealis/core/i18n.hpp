@@ -76,6 +76,13 @@ std::string getStr(std::string stringName, Args&&... args)
  */
 void loadTranslations();
 
+/**
+ * Loads all translations of the current system locale + default locale
+ * in the background, as startup tasks (see brls::Startup).
+ * Getting a translation waits for them to be loaded.
+ */
+void loadTranslationsAsync();
+
 inline namespace literals
 {
     /**
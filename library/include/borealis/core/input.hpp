@@ -20,6 +20,7 @@
 #include <nanovg.h>
 #include <borealis/core/geometry.hpp>
 #include <borealis/core/event.hpp>
+#include <borealis/core/time.hpp>
 #include <vector>
 
 #define GAMEPADS_MAX 2
@@ -247,6 +248,7 @@ struct RawTouchState
     int fingerId = 0;
     bool pressed = false;
     Point position;
+    Time timestamp = 0; // CPU time in microseconds when the sample was read, 0 to let the library stamp it
 };
 
 // Contains touch data automatically filled with current phase by the library
@@ -256,7 +258,8 @@ struct TouchState
     int fingerId     = 0;
     TouchPhase phase = TouchPhase::NONE;
     Point position;
-    View* view = nullptr;
+    Time timestamp = 0; // CPU time in microseconds when the sample was read
+    View* view     = nullptr;
 };
 
 // Contains raw touch data, filled in by platform driver
@@ -268,6 +271,7 @@ struct RawMouseState
     bool leftButton   = false;
     bool middleButton = false;
     bool rightButton  = false;
+    Time timestamp    = 0; // CPU time in microseconds when the sample was read, 0 to let the library stamp it
 };
 
 struct MouseState
@@ -278,6 +282,7 @@ struct MouseState
     TouchPhase leftButton = TouchPhase::NONE;
     TouchPhase middleButton = TouchPhase::NONE;
     TouchPhase rightButton = TouchPhase::NONE;
+    Time timestamp = 0; // CPU time in microseconds when the sample was read
     View* view = nullptr;
 };
 
@@ -0,0 +1,212 @@
+/*
+    Copyright 2021 XITRIX
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace brls
+{
+
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+constexpr uint64_t FNV_PRIME        = 0x100000001b3ull;
+
+// 64 bits FNV-1a hash of a string, stopping at the first null character
+constexpr uint64_t hashKey(const char* name, size_t length)
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (size_t i = 0; i < length && name[i] != '\0'; i++)
+        hash = (hash ^ (uint64_t)(unsigned char)name[i]) * FNV_PRIME;
+
+    // 0 marks empty slots in the key tables
+    return hash != 0 ? hash : 1;
+}
+
+namespace internal
+{
+
+    // Same as hashKey(), unrolled so that the compiler folds it
+    // into a constant for string literals, even outside of constant expressions
+    template <size_t N, size_t... I>
+    constexpr uint64_t hashKeyLiteral(const char (&name)[N], std::index_sequence<I...>)
+    {
+        uint64_t hash = FNV_OFFSET_BASIS;
+        bool end      = false;
+        ((end = end || name[I] == '\0', hash = end ? hash : (hash ^ (uint64_t)(unsigned char)name[I]) * FNV_PRIME), ...);
+
+        return hash != 0 ? hash : 1;
+    }
+
+} // namespace internal
+
+// Name of a style metric or theme color, reduced to its hash
+//
+// String literals are hashed at compile time, so looking up a value
+// with a literal never hashes nor allocates a string at runtime.
+// Other strings are hashed when the key is built.
+class InternedKey
+{
+  public:
+    template <size_t N>
+    constexpr InternedKey(const char (&name)[N])
+        : hash(internal::hashKeyLiteral(name, std::make_index_sequence<N - 1>()))
+        , name(name)
+    {
+    }
+
+    InternedKey(const std::string& name)
+        : hash(hashKey(name.c_str(), name.size()))
+        , name(name.c_str())
+    {
+    }
+
+    // Names held in a pointer are hashed at runtime, a template so
+    // that string literals still go to the compile time constructor
+    template <typename T, typename std::enable_if<std::is_same<T, const char*>::value || std::is_same<T, char*>::value, int>::type = 0>
+    InternedKey(T name)
+        : hash(hashKey(name, SIZE_MAX))
+        , name(name)
+    {
+    }
+
+    /**
+     * Builds a key from a hash computed ahead of time with hashKey(),
+     * by the layouts compiler for instance.
+     */
+    constexpr InternedKey(uint64_t hash, const char* name)
+        : hash(hash)
+        , name(name)
+    {
+    }
+
+    constexpr uint64_t getHash() const
+    {
+        return this->hash;
+    }
+
+    /**
+     * Returns the name of the key, only meant for error messages:
+     * it is not owned by the key and only lives as long as the string
+     * the key was built from.
+     */
+    constexpr const char* getName() const
+    {
+        return this->name;
+    }
+
+  private:
+    uint64_t hash;
+    const char* name;
+};
+
+// Table of values indexed by interned keys
+// Open addressing on the key hashes: a lookup usually reads a single slot.
+template <typename T>
+class KeyTable
+{
+  public:
+    /**
+     * Adds a value to the table. Does nothing if there
+     * already is a value with that name.
+     * Returns false if the name collides with another one.
+     */
+    bool insert(const std::string& name, T value)
+    {
+        if ((this->count + 1) * 2 > this->hashes.size())
+            this->grow();
+
+        uint64_t hash = hashKey(name.c_str(), name.size());
+        size_t slot   = this->findSlot(hash);
+
+        if (this->hashes[slot] == hash)
+            return this->names[slot] == name;
+
+        this->hashes[slot] = hash;
+        this->values[slot] = value;
+        this->names[slot]  = name;
+        this->count++;
+        return true;
+    }
+
+    /**
+     * Returns the value of the given key, or nullptr if there is none.
+     */
+    T* find(InternedKey key)
+    {
+        if (this->count == 0)
+            return nullptr;
+
+        size_t slot = this->findSlot(key.getHash());
+        return this->hashes[slot] == key.getHash() ? &this->values[slot] : nullptr;
+    }
+
+    const T* find(InternedKey key) const
+    {
+        if (this->count == 0)
+            return nullptr;
+
+        size_t slot = this->findSlot(key.getHash());
+        return this->hashes[slot] == key.getHash() ? &this->values[slot] : nullptr;
+    }
+
+  private:
+    std::vector<uint64_t> hashes;
+    std::vector<T> values;
+    std::vector<std::string> names;
+    size_t count = 0;
+
+    // Returns the slot of the given hash, or the empty slot where it would go
+    size_t findSlot(uint64_t hash) const
+    {
+        size_t mask = this->hashes.size() - 1;
+        size_t slot = hash & mask;
+
+        while (this->hashes[slot] != 0 && this->hashes[slot] != hash)
+            slot = (slot + 1) & mask;
+
+        return slot;
+    }
+
+    void grow()
+    {
+        std::vector<uint64_t> oldHashes   = std::move(this->hashes);
+        std::vector<T> oldValues          = std::move(this->values);
+        std::vector<std::string> oldNames = std::move(this->names);
+        size_t capacity                   = oldHashes.empty() ? 64 : oldHashes.size() * 2;
+
+        this->hashes.assign(capacity, 0);
+        this->values.assign(capacity, T());
+        this->names.assign(capacity, std::string());
+
+        for (size_t i = 0; i < oldHashes.size(); i++)
+        {
+            if (oldHashes[i] == 0)
+                continue;
+
+            size_t slot        = this->findSlot(oldHashes[i]);
+            this->hashes[slot] = oldHashes[i];
+            this->values[slot] = oldValues[i];
+            this->names[slot]  = std::move(oldNames[i]);
+        }
+    }
+};
+
+} // namespace brls
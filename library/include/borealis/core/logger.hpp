@@ -17,10 +17,39 @@
 
 #pragma once
 
-#include <fmt/core.h>
+#include <fmt/format.h>
 
+#include <atomic>
 #include <borealis/core/event.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <thread>
+
+// Most verbose log level compiled in, see LogLevel: 0 for errors only, 3 for everything
+// Log calls made through the BRLS_LOG_* macros below that level are removed at compile time.
+#ifndef BRLS_MAX_LOG_LEVEL
+#define BRLS_MAX_LOG_LEVEL 3
+#endif
+
+// Logs a message if the level is enabled. Unlike the Logger methods, the arguments
+// are only evaluated when the message is actually logged, so they can be expensive.
+#define BRLS_LOG(level, ...)                                  \
+    do                                                        \
+    {                                                         \
+        if constexpr ((int)(level) <= BRLS_MAX_LOG_LEVEL)     \
+        {                                                     \
+            if (::brls::Logger::isEnabled(level))             \
+                ::brls::Logger::log((level), __VA_ARGS__);    \
+        }                                                     \
+    } while (0)
+
+#define BRLS_LOG_ERROR(...) BRLS_LOG(::brls::LogLevel::ERROR, __VA_ARGS__)
+#define BRLS_LOG_WARNING(...) BRLS_LOG(::brls::LogLevel::WARNING, __VA_ARGS__)
+#define BRLS_LOG_INFO(...) BRLS_LOG(::brls::LogLevel::INFO, __VA_ARGS__)
+#define BRLS_LOG_DEBUG(...) BRLS_LOG(::brls::LogLevel::DEBUG, __VA_ARGS__)
 
 namespace brls
 {
@@ -33,69 +62,144 @@ enum class LogLevel
     DEBUG
 };
 
+// Formatted message, in a slot of the logger ring buffer
+struct LogMessage
+{
+    static constexpr size_t CAPACITY = 256;
+
+    std::atomic<size_t> sequence = 0; // twice the ring buffer lap, plus one once written
+    LogLevel level               = LogLevel::INFO;
+
+    size_t length = 0;
+    char text[CAPACITY];
+    std::string overflow; // whole message if it doesn't fit in the text
+
+    std::string_view getText() const
+    {
+        return this->overflow.empty() ? std::string_view(this->text, this->length) : std::string_view(this->overflow);
+    }
+};
+
+// Messages are formatted once, on the calling thread, into a lock-free
+// ring buffer. A background thread drains it to the standard output
+// and to the log event subscribers.
+//
+// Before start() and after stop(), messages are written right away.
 class Logger
 {
   public:
     static void setLogLevel(LogLevel logLevel);
 
+    inline static bool isEnabled(LogLevel logLevel)
+    {
+        return (int)logLevel <= BRLS_MAX_LOG_LEVEL && logLevel <= Logger::logLevel.load(std::memory_order_relaxed);
+    }
+
     template <typename... Args>
-    inline static void log(LogLevel logLevel, std::string prefix, std::string color, std::string format, Args&&... args)
+    inline static void log(LogLevel logLevel, fmt::string_view format, const Args&... args)
     {
-        if (Logger::logLevel < logLevel)
+        if (!Logger::isEnabled(logLevel))
             return;
 
+        LogMessage* message = Logger::beginMessage(logLevel);
+
         try
         {
-            fmt::print("\033{}[{}]\033[0m ", color, prefix);
-            fmt::print(format, args...);
-            fmt::print("\n");
+            auto result = fmt::format_to_n(message->text, LogMessage::CAPACITY, format, args...);
 
-            std::string log = fmt::format(format, args...);
-            logEvent.fire(log);
+            // Too long for the slot: format it again, in full
+            if (result.size > LogMessage::CAPACITY)
+                message->overflow = fmt::format(format, args...);
+            else
+                message->length = result.size;
         }
         catch (const std::exception& e)
         {
-            // will be printed after the first fmt::print (so after the log tag)
-            printf("! Invalid log format string: \"%s\": %s\n", format.c_str(), e.what());
+            message->overflow = fmt::format("! Invalid log format string: \"{}\": {}", format, e.what());
         }
 
-#ifdef __MINGW32__
-        fflush(0);
-#endif
+        Logger::commitMessage(message);
     }
 
     template <typename... Args>
-    inline static void error(std::string format, Args&&... args)
+    inline static void error(fmt::string_view format, const Args&... args)
     {
-        Logger::log(LogLevel::ERROR, "ERROR", "[0;31m", format, args...);
+        Logger::log(LogLevel::ERROR, format, args...);
     }
 
     template <typename... Args>
-    inline static void warning(std::string format, Args&&... args)
+    inline static void warning(fmt::string_view format, const Args&... args)
     {
-        Logger::log(LogLevel::WARNING, "WARNING", "[0;33m", format, args...);
+        Logger::log(LogLevel::WARNING, format, args...);
     }
 
     template <typename... Args>
-    inline static void info(std::string format, Args&&... args)
+    inline static void info(fmt::string_view format, const Args&... args)
     {
-        Logger::log(LogLevel::INFO, "INFO", "[0;34m", format, args...);
+        Logger::log(LogLevel::INFO, format, args...);
     }
 
     template <typename... Args>
-    inline static void debug(std::string format, Args&&... args)
+    inline static void debug(fmt::string_view format, const Args&... args)
     {
-        Logger::log(LogLevel::DEBUG, "DEBUG", "[0;32m", format, args...);
+        Logger::log(LogLevel::DEBUG, format, args...);
     }
 
-    static Event<std::string>* getLogEvent()
+    /**
+     * Fired with every logged message, from the logger thread.
+     * The message is only valid for the duration of the call.
+     *
+     * Use subscribe() and unsubscribe() to change the subscribers
+     * while messages are being logged.
+     */
+    static Event<std::string_view>* getLogEvent()
     {
         return &logEvent;
     }
 
+    static Event<std::string_view>::Subscription subscribe(Event<std::string_view>::Callback callback);
+    static void unsubscribe(Event<std::string_view>::Subscription subscription);
+
+    /**
+     * Starts the logger thread.
+     * It's stopped by stop(), or when the process exits.
+     */
+    static void start();
+
+    /**
+     * Writes the remaining messages and stops the logger thread.
+     */
+    static void stop();
+
+    /**
+     * Waits for every message logged so far to be written.
+     */
+    static void flush();
+
   private:
-    inline static LogLevel logLevel = LogLevel::INFO;
-    inline static Event<std::string> logEvent;
+    inline static std::atomic<LogLevel> logLevel = LogLevel::INFO;
+    inline static Event<std::string_view> logEvent;
+    inline static std::recursive_mutex logEventMutex; // subscribers can log
+
+    inline static std::thread thread; // only touched by start() and stop()
+    inline static std::atomic<std::thread::id> threadId;
+    inline static std::atomic<bool> running = false;
+    inline static std::mutex threadMutex;
+    inline static std::condition_variable threadCondition;
+
+    inline static std::atomic<size_t> enqueuePosition = 0;
+    inline static std::atomic<size_t> dequeuePosition = 0; // only moved by the logger thread
+    inline static std::atomic<size_t> producers       = 0; // threads claiming or writing a ring buffer slot
+
+    // Returns the slot to format the message into: a ring buffer slot,
+    // or a heap allocated one if the message must be written right away
+    // (not a thread local one, as subscribers can log while it's written)
+    static LogMessage* beginMessage(LogLevel logLevel);
+    static void commitMessage(LogMessage* message);
+
+    static void loop();
+    static bool drain();
+    static void write(const LogMessage* message);
 };
 
 } // namespace brls
@@ -0,0 +1,117 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <borealis/core/event.hpp>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace brls
+{
+
+struct BatteryStatus
+{
+    int level     = 0; // in percents
+    bool charging = false;
+
+    bool operator==(const BatteryStatus& other) const
+    {
+        return this->level == other.level && this->charging == other.charging;
+    }
+
+    bool operator!=(const BatteryStatus& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+struct WirelessStatus
+{
+    bool connected = false;
+    int level      = 0; // signal strength, from 0 to 3
+
+    bool operator==(const WirelessStatus& other) const
+    {
+        return this->connected == other.connected && this->level == other.level;
+    }
+
+    bool operator!=(const WirelessStatus& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+// Battery, wireless and clock status shown by the bottom bar
+//
+// Querying the platform is an IPC on some of them, so the status is polled
+// once per second by a background thread, started the first time it's needed.
+// Events are only fired when a value changes, always on the main thread, and
+// the getters return the last value fired. Main thread only, except stop().
+class PlatformStatus
+{
+  public:
+    static BatteryStatus getBattery();
+    static WirelessStatus getWireless();
+
+    /**
+     * Returns the local time, formatted as "HH:MM:SS".
+     */
+    static std::string getTime();
+
+    static Event<BatteryStatus>* getBatteryChangeEvent();
+    static Event<WirelessStatus>* getWirelessChangeEvent();
+    static Event<std::string>* getTimeChangeEvent();
+
+    /**
+     * Stops the polling thread, called by the application
+     * before the platform is destroyed, and when the process exits.
+     */
+    static void stop();
+
+  private:
+    // Last values fired, only touched by the main thread
+    inline static BatteryStatus battery;
+    inline static WirelessStatus wireless;
+    inline static std::string time;
+
+    inline static Event<BatteryStatus> batteryChangeEvent;
+    inline static Event<WirelessStatus> wirelessChangeEvent;
+    inline static Event<std::string> timeChangeEvent;
+
+    // Last values polled, only touched by the polling thread once it's started
+    inline static BatteryStatus polledBattery;
+    inline static WirelessStatus polledWireless;
+    inline static std::string polledTime;
+
+    inline static bool started = false;
+
+    inline static std::thread thread;
+    inline static std::atomic<bool> running = false;
+    inline static std::mutex threadMutex;
+    inline static std::condition_variable threadCondition;
+
+    // Polls the values right away then starts the polling thread, only once
+    static void start();
+
+    static void loop();
+    static void poll(bool notify);
+};
+
+} // namespace brls
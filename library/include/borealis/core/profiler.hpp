@@ -0,0 +1,75 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/time.hpp>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace brls
+{
+
+// A value measured by the library, such as a queue depth or
+// the time spent in a step of the main loop
+// Metrics are meant to be recorded from the main thread
+struct ProfilerMetric
+{
+    std::string name;
+
+    double last    = 0; // last recorded value
+    double max     = 0; // maximum recorded value
+    double average = 0; // exponential moving average of the recorded values
+    size_t samples = 0; // amount of recorded values
+
+    void record(double value);
+    void reset();
+};
+
+// Registry of the library metrics
+//
+// Metrics are created once and live for the whole application lifetime,
+// so callers can keep the pointer to avoid looking them up every frame.
+class Profiler
+{
+  public:
+    /**
+     * Returns the metric with the given name, creating it if needed.
+     */
+    static ProfilerMetric* getMetric(std::string name);
+
+    /**
+     * Returns every metric registered so far.
+     */
+    static std::vector<ProfilerMetric*> getMetrics();
+
+    /**
+     * Resets the recorded values of every metric.
+     */
+    static void reset();
+
+    /**
+     * Prints every metric to the log, at the info level.
+     */
+    static void dump();
+
+  private:
+    inline static std::mutex metricsMutex;
+    inline static std::vector<ProfilerMetric*> metrics;
+};
+
+} // namespace brls
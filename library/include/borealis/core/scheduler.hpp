@@ -0,0 +1,119 @@
+/*
+    Copyright 2021 XITRIX
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/time.hpp>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace brls
+{
+
+// Handle to a scheduled timer, used to cancel it
+// A default constructed handle never refers to any timer
+struct TimerHandle
+{
+    uint32_t index      = 0;
+    uint32_t generation = 0;
+
+    bool isValid() const
+    {
+        return generation != 0;
+    }
+};
+
+// Schedules functions to be executed on the main thread once a deadline is reached.
+// Timers are kept in a binary min-heap keyed by deadline: scheduling and cancelling
+// are O(log n), and checking for due timers every frame only looks at the top of the heap.
+//
+// Timers can be scheduled and cancelled from any thread, they are always executed
+// by the main thread at the beginning of the frame.
+class Scheduler
+{
+  public:
+    /**
+     * Schedules a function to be executed after the given delay, in ms.
+     * Returns a handle that can be used to cancel it.
+     */
+    static TimerHandle schedule(Time delay, const std::function<void()>& func);
+
+    /**
+     * Schedules a function to be executed at the given deadline, in us,
+     * as given by getTimeUsec().
+     */
+    static TimerHandle scheduleAt(Time deadline, const std::function<void()>& func);
+
+    /**
+     * Cancels a pending timer. Returns false if the timer already ran
+     * or was already cancelled.
+     */
+    static bool cancel(TimerHandle handle);
+
+    /**
+     * Returns true if the timer is still waiting for its deadline.
+     */
+    static bool isPending(TimerHandle handle);
+
+    /**
+     * Returns the deadline of the next timer in us, as given
+     * by getTimeUsec(), or false if no timer is pending.
+     */
+    static bool getNextDeadline(Time* deadline);
+
+    /**
+     * Returns the amount of pending timers.
+     */
+    static size_t getPendingCount();
+
+    /**
+     * Called internally when the clock is replaced. Moves every pending
+     * deadline by the given offset, in us, from the previous clock to the new one.
+     */
+    static void rebase(Time offset);
+
+    /**
+     * Called internally by the main loop. Executes every timer that is due.
+     * Timers scheduled by a running timer are executed next frame at the earliest.
+     */
+    static void runDueTimers();
+
+  private:
+    struct Slot
+    {
+        Time deadline       = 0;
+        uint64_t sequence   = 0; // keeps timers with the same deadline in order
+        size_t heapIndex    = 0;
+        uint32_t generation = 1;
+        std::function<void()> func;
+    };
+
+    inline static std::mutex m_mutex;
+    inline static std::vector<Slot> m_slots;
+    inline static std::vector<uint32_t> m_free_slots;
+    inline static std::vector<uint32_t> m_heap; // slot indexes
+    inline static uint64_t m_sequence = 0;
+
+    static bool is_before(uint32_t a, uint32_t b);
+    static void place(size_t position, uint32_t slot);
+    static void sift_up(size_t position);
+    static void sift_down(size_t position);
+    static void remove_at(size_t position);
+};
+
+} // namespace brls
@@ -0,0 +1,148 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <borealis/core/time.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace brls
+{
+
+typedef size_t StartupTaskId;
+
+// Thread a startup task is executed on
+enum class StartupThread
+{
+    WORKER, // async worker pool: file reads, parsing...
+    MAIN, // main thread: anything touching the graphics context or the views
+    MILESTONE, // not executed, completed with Startup::reach()
+};
+
+enum class StartupTaskState
+{
+    PENDING, // waiting for its dependencies
+    READY, // queued
+    RUNNING,
+    DONE,
+};
+
+struct StartupTask
+{
+    std::string name;
+    StartupThread thread;
+    std::function<void()> function;
+
+    std::vector<StartupTaskId> dependents;
+    size_t pendingDependencies = 0;
+
+    bool blocking          = false;
+    StartupTaskState state = StartupTaskState::PENDING;
+};
+
+// Dependency graph of the loading tasks run when the application starts
+//
+// Tasks start as soon as all of their dependencies are done, worker tasks
+// in parallel on the async pool. Blocking tasks (and everything they depend on)
+// are the ones needed to draw the first frame: the application waits for them
+// before entering the main loop. The other tasks keep loading in the background,
+// non blocking main thread tasks only run once the first frame is drawn.
+//
+// Every task duration is recorded in the "startup/<name>Usec" profiler metric.
+class Startup
+{
+  public:
+    /**
+     * Adds a task to the graph, to be executed once all the given tasks are done.
+     * Blocking is ignored once the application waited for the blocking tasks.
+     */
+    static StartupTaskId add(std::string name, StartupThread thread, std::function<void()> function, std::vector<StartupTaskId> dependencies = {}, bool blocking = true);
+
+    /**
+     * Adds a milestone: a task that is not executed, but completed by
+     * calling reach(), to make other tasks depend on something happening
+     * outside of the graph (the window being created...).
+     */
+    static StartupTaskId addMilestone(std::string name, bool blocking = true);
+
+    /**
+     * Completes the given milestone.
+     */
+    static void reach(StartupTaskId milestone);
+
+    /**
+     * Returns true if the given task is done.
+     */
+    static bool isDone(StartupTaskId task);
+
+    /**
+     * Waits for the given task to be done. On the main thread,
+     * queued main thread tasks are executed while waiting.
+     */
+    static void wait(StartupTaskId task);
+
+    /**
+     * Waits for every blocking task to be done, executing
+     * the blocking main thread tasks while waiting.
+     * Called by the application before the first frame.
+     */
+    static void waitForBlockingTasks();
+
+    /**
+     * Called by the application once the first frame is drawn,
+     * releases the non blocking main thread tasks and reports the
+     * time to first frame.
+     */
+    static void onFirstFrame();
+
+    /**
+     * Starts measuring the time to first frame,
+     * must be called from the main thread.
+     */
+    static void begin();
+
+  private:
+    inline static std::mutex mutex;
+    inline static std::condition_variable condition;
+
+    inline static std::deque<StartupTask> tasks; // indexed by id, never moved
+    inline static std::deque<StartupTaskId> mainQueue; // ready main thread tasks
+
+    inline static size_t blockingLeft = 0;
+    inline static bool released       = false; // blocking tasks are done
+    inline static bool painted        = false; // first frame is drawn
+
+    inline static std::thread::id mainThread;
+    inline static Time startTime   = 0;
+    inline static Time blockedTime = 0;
+
+    static void run(StartupTaskId id);
+    static void complete(StartupTaskId id, Time duration);
+
+    // Must be called with the mutex held
+    static void schedule(StartupTaskId id);
+    static void markBlocking(StartupTaskId id);
+    static bool popMainTask(bool blockingOnly, StartupTaskId* id);
+};
+
+} // namespace brls
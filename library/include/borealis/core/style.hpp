@@ -18,9 +18,9 @@
 
 #pragma once
 
+#include <borealis/core/interned_key.hpp>
 #include <initializer_list>
 #include <string>
-#include <unordered_map>
 
 namespace brls
 {
@@ -31,10 +31,10 @@ class StyleValues
     StyleValues(std::initializer_list<std::pair<std::string, float>> list);
 
     void addMetric(std::string name, float value);
-    float getMetric(std::string name);
+    float getMetric(InternedKey name);
 
   private:
-    std::unordered_map<std::string, float> values;
+    KeyTable<float> values;
 };
 
 // Simple wrapper around StyleValues for the array operator
@@ -42,10 +42,10 @@ class Style
 {
   public:
     Style(StyleValues* values);
-    float operator[](std::string name);
+    float operator[](InternedKey name);
 
     void addMetric(std::string name, float value);
-    float getMetric(std::string name);
+    float getMetric(InternedKey name);
 
   private:
     StyleValues* values;
@@ -0,0 +1,165 @@
+/*
+    Copyright 2021 XITRIX
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <borealis/core/time.hpp>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace brls
+{
+
+// Callable stored inline in a queue node
+// Captures bigger than the inline storage fall back to a heap allocation
+class InlineFunction
+{
+  public:
+    static constexpr size_t CAPACITY = 64;
+
+    InlineFunction() = default;
+    InlineFunction(const InlineFunction&) = delete;
+    InlineFunction& operator=(const InlineFunction&) = delete;
+
+    ~InlineFunction()
+    {
+        this->reset();
+    }
+
+    template <typename F>
+    void emplace(F&& func)
+    {
+        using Func = std::decay_t<F>;
+
+        this->reset();
+
+        if constexpr (sizeof(Func) <= CAPACITY && alignof(Func) <= alignof(std::max_align_t))
+        {
+            new (this->storage) Func(std::forward<F>(func));
+            this->invoker   = [](void* storage) { (*static_cast<Func*>(storage))(); };
+            this->destroyer = [](void* storage) { static_cast<Func*>(storage)->~Func(); };
+        }
+        else
+        {
+            *reinterpret_cast<Func**>(this->storage) = new Func(std::forward<F>(func));
+            this->invoker                              = [](void* storage) { (**static_cast<Func**>(storage))(); };
+            this->destroyer                            = [](void* storage) { delete *static_cast<Func**>(storage); };
+        }
+    }
+
+    void operator()()
+    {
+        this->invoker(this->storage);
+    }
+
+    void reset()
+    {
+        if (this->destroyer)
+            this->destroyer(this->storage);
+
+        this->invoker   = nullptr;
+        this->destroyer = nullptr;
+    }
+
+  private:
+    alignas(std::max_align_t) unsigned char storage[CAPACITY];
+    void (*invoker)(void*)   = nullptr;
+    void (*destroyer)(void*) = nullptr;
+};
+
+struct ProfilerMetric;
+
+struct SyncTaskNode
+{
+    std::atomic<SyncTaskNode*> next = nullptr; // next node in the queue
+    SyncTaskNode* poolNext          = nullptr; // next node in the pool free list
+    Time timestamp                  = 0; // time of the push, in us
+    InlineFunction func;
+};
+
+// Pool of sync task nodes shared by every queue
+//
+// Every thread takes nodes from its own cache, refilled by taking
+// all the released nodes at once, so that allocating never
+// contends with the thread releasing nodes.
+class SyncTaskPool
+{
+  public:
+    static SyncTaskNode* allocate();
+
+    /**
+     * Gives a chain of nodes, linked by poolNext, back to the pool.
+     */
+    static void release(SyncTaskNode* first, SyncTaskNode* last);
+
+  private:
+    inline static std::atomic<SyncTaskNode*> releasedNodes = nullptr;
+};
+
+// Lock-free multiple producers single consumer queue of tasks
+//
+// Any thread can push tasks, only one thread (the main thread)
+// can drain them. Tasks are executed in place, from their node.
+class SyncQueue
+{
+  public:
+    SyncQueue();
+
+    template <typename F>
+    void push(F&& func)
+    {
+        SyncTaskNode* node = SyncTaskPool::allocate();
+        node->func.emplace(std::forward<F>(func));
+        node->timestamp = getCPUTimeUsec();
+        this->pushNode(node);
+    }
+
+    /**
+     * Runs every task pushed before the call.
+     * Tasks pushed by the tasks themselves wait for the next drain.
+     * Consumer thread only. Returns the amount of tasks executed.
+     *
+     * If a deadline is given, in us, no task is started past it and the
+     * remaining ones are left for the next drain. At least one task
+     * is always executed so that the queue keeps moving.
+     *
+     * If a metric is given, the time every task spent in the queue is recorded in it.
+     */
+    size_t drain(Time deadline = 0, ProfilerMetric* latencyMetric = nullptr);
+
+    /**
+     * Returns the amount of tasks waiting in the queue.
+     */
+    size_t getDepth() const
+    {
+        return this->depth.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<SyncTaskNode*> head; // last pushed node, producers side
+    SyncTaskNode* tail; // next node to pop, consumer side
+    SyncTaskNode stub;
+
+    std::atomic<size_t> depth = 0;
+
+    void pushNode(SyncTaskNode* node);
+    SyncTaskNode* popNode();
+};
+
+} // namespace brls
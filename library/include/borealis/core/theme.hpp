@@ -19,9 +19,9 @@
 
 #include <nanovg.h>
 
+#include <borealis/core/interned_key.hpp>
 #include <initializer_list>
 #include <string>
-#include <unordered_map>
 
 namespace brls
 {
@@ -38,10 +38,10 @@ class ThemeValues
     ThemeValues(std::initializer_list<std::pair<std::string, NVGcolor>> list);
 
     void addColor(std::string name, NVGcolor color);
-    NVGcolor getColor(std::string name);
+    NVGcolor getColor(InternedKey name);
 
   private:
-    std::unordered_map<std::string, NVGcolor> values;
+    KeyTable<NVGcolor> values;
 };
 
 // Simple wrapper around ThemeValues for the array operator
@@ -49,10 +49,10 @@ class Theme
 {
   public:
     Theme(ThemeValues* values);
-    NVGcolor operator[](std::string name);
+    NVGcolor operator[](InternedKey name) const;
 
     void addColor(std::string name, NVGcolor color);
-    NVGcolor getColor(std::string name);
+    NVGcolor getColor(InternedKey name) const;
 
   private:
     ThemeValues* values;
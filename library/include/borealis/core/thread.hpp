@@ -18,8 +18,13 @@
 
 #include <unistd.h>
 
-#include <chrono>
+#include <atomic>
+#include <borealis/core/scheduler.hpp>
+#include <borealis/core/sync_queue.hpp>
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -27,6 +32,28 @@
 namespace brls
 {
 
+// Order in which queued async tasks are picked up by the workers
+enum class TaskPriority
+{
+    HIGH = 0,
+    NORMAL,
+    LOW,
+
+    _PRIORITY_MAX,
+};
+
+// Lane of the sync queue a function is executed from
+enum class SyncPriority
+{
+    CRITICAL = 0, // always executed next frame, regardless of the budget (input handling...)
+    NORMAL, // executed within the sync budget, the rest is carried over to the next frame
+    IDLE, // executed only when the normal lane is empty and there is budget left
+
+    _PRIORITY_MAX,
+};
+
+class Threading;
+
 /**
  * Enqueue a function to be executed before
  * the application is redrawn the next time.
@@ -34,9 +61,19 @@ namespace brls
  * Borealis is not thread-safe, and sync() provides a mechanism
  * for queuing up UI-related state changes from other threads.
  *
- * It's a shortcut for brls::Application::sync(&func);
+ * It's a shortcut for brls::Threading::sync(func);
+ */
+template <typename F>
+void sync(F&& func);
+
+/**
+ * Enqueue a function to be executed on the main thread
+ * from the given lane of the sync queue.
+ *
+ * It's a shortcut for brls::Threading::sync(func, priority);
  */
-extern void sync(const std::function<void()>& func);
+template <typename F>
+void sync(F&& func, SyncPriority priority);
 
 /**
  * Enqueue a function to be executed in
@@ -46,13 +83,42 @@ extern void sync(const std::function<void()>& func);
  */
 extern void async(const std::function<void()>& func);
 
-extern void delay(long milliseconds, const std::function<void()>& func);
+/**
+ * Enqueue a function to be executed in parallel with
+ * application's main thread, with the given priority.
+ */
+extern void async(const std::function<void()>& func, TaskPriority priority);
+
+/**
+ * Enqueue a function to be executed on the main thread
+ * once the given delay has passed.
+ *
+ * It's a shortcut for brls::Threading::delay(milliseconds, func);
+ */
+extern TimerHandle delay(long milliseconds, const std::function<void()>& func);
+
+/**
+ * Cancels a delayed function that did not run yet.
+ *
+ * It's a shortcut for brls::Threading::cancelDelay(handle);
+ */
+extern bool cancelDelay(TimerHandle handle);
 
-struct DelayOperation
+// Queue of async tasks, one deque per priority
+struct TaskQueue
 {
-    std::chrono::high_resolution_clock::time_point startPoint;
-    long delayMilliseconds;
-    std::function<void()> func;
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks[(size_t)TaskPriority::_PRIORITY_MAX];
+
+    void push(const std::function<void()>& task, TaskPriority priority);
+
+    // Pops the task with the highest priority, returns false if the queue is empty
+    bool pop(std::function<void()>* task);
+
+    // Pops the task with the lowest priority, used by idle workers stealing work
+    bool steal(std::function<void()>* task);
+
+    void clear();
 };
 
 class Threading
@@ -66,16 +132,63 @@ class Threading
      *
      * Borealis is not thread-safe, and sync() provides a mechanism
      * for queuing up UI-related state changes from other threads.
+     *
+     * Lock-free: calling it from a worker thread never
+     * waits for the main thread, and the other way around.
+     *
+     * If a sync budget is set, only functions of the critical lane
+     * are guaranteed to run before the next redraw.
      */
-    static void sync(const std::function<void()>& func);
+    template <typename F>
+    static void sync(F&& func, SyncPriority priority = SyncPriority::NORMAL)
+    {
+        m_sync_queues[(size_t)priority].push(std::forward<F>(func));
+    }
 
     /**
      * Enqueue a function to be executed in
      * parallel with application's main thread.
+     *
+     * Tasks are executed by a pool of worker threads, in
+     * priority order, so there is no guarantee that two
+     * tasks enqueued one after the other run sequentially.
      */
-    static void async(const std::function<void()>& func);
+    static void async(const std::function<void()>& func, TaskPriority priority = TaskPriority::NORMAL);
 
-    static void delay(long milliseconds, const std::function<void()>& func);
+    /**
+     * Enqueue a function to be executed on the main thread
+     * once the given delay has passed.
+     *
+     * Returns a handle that can be given to cancelDelay().
+     */
+    static TimerHandle delay(long milliseconds, const std::function<void()>& func);
+
+    /**
+     * Cancels a delayed function that did not run yet.
+     * Returns false if it already ran or was already cancelled.
+     */
+    static bool cancelDelay(TimerHandle handle);
+
+    /**
+     * Sets the amount of worker threads executing async tasks.
+     * 0 means one worker per hardware thread, minus the main one.
+     * Must be called before start() to have effect.
+     */
+    static void setWorkersCount(unsigned count);
+
+    /**
+     * Returns the amount of running worker threads.
+     */
+    static size_t getWorkersCount();
+
+    /**
+     * Enables or disables work stealing, disabled by default.
+     *
+     * When enabled, tasks enqueued from a worker thread are kept in
+     * the local queue of that worker, idle workers will then take
+     * them over. Otherwise every task goes through the shared queue.
+     */
+    static void setWorkStealing(bool enabled);
 
     static void start();
 
@@ -83,31 +196,64 @@ class Threading
 
     static void performSyncTasks();
 
-    static std::vector<std::function<void()>>* getSyncFunctions()
-    {
-        return &m_sync_functions;
-    }
+    /**
+     * Sets the time the main thread can spend running sync functions
+     * every frame, in us. Functions that don't fit are carried over to
+     * the next frame. 0 means no limit, which is the default.
+     */
+    static void setSyncBudget(Time budget);
+
+    static Time getSyncBudget();
+
+    /**
+     * Returns the amount of sync functions waiting for the next frame.
+     */
+    static size_t getSyncQueueDepth();
 
-    static std::vector<std::function<void()>>* getAsyncTasks()
+    /**
+     * Returns the amount of sync functions waiting in the given lane.
+     */
+    static size_t getSyncQueueDepth(SyncPriority priority)
     {
-        return &m_async_tasks;
+        return m_sync_queues[(size_t)priority].getDepth();
     }
 
   private:
-    inline static std::mutex m_sync_mutex;
-    inline static std::vector<std::function<void()>> m_sync_functions;
+    inline static SyncQueue m_sync_queues[(size_t)SyncPriority::_PRIORITY_MAX];
+    inline static Time sync_budget = 0;
+
+    inline static TaskQueue m_async_tasks;
+    inline static std::vector<std::unique_ptr<TaskQueue>> m_worker_tasks;
+    inline static std::vector<std::thread> m_workers;
+
+    inline static std::mutex m_wakeup_mutex;
+    inline static std::condition_variable m_wakeup_condition;
+    inline static long m_pending_tasks = 0; // guarded by m_wakeup_mutex
 
-    inline static std::mutex m_async_mutex;
-    inline static std::vector<std::function<void()>> m_async_tasks;
+    inline static unsigned workers_count            = 0;
+    inline static std::atomic_bool work_stealing    = false;
+    inline static std::atomic_bool task_loop_active = false;
 
-    inline static std::mutex m_delay_mutex;
-    inline static std::vector<DelayOperation> m_delay_tasks;
+    // Index of the worker running on the current thread, -1 outside of the pool
+    inline static thread_local int current_worker = -1;
 
-    inline static volatile bool task_loop_active = true;
+    static void task_loop(int worker);
 
-    static void* task_loop(void* a);
+    static bool take_task(int worker, std::function<void()>* task);
 
     static void start_task_loop();
 };
 
+template <typename F>
+void sync(F&& func)
+{
+    Threading::sync(std::forward<F>(func));
+}
+
+template <typename F>
+void sync(F&& func, SyncPriority priority)
+{
+    Threading::sync(std::forward<F>(func), priority);
+}
+
 } // namespace brls
@@ -19,8 +19,9 @@
 #include <libretro-common/features/features_cpu.h>
 #include <libretro-common/libretro.h>
 
+#include <atomic>
+#include <cstddef>
 #include <functional>
-#include <vector>
 
 namespace brls
 {
@@ -29,12 +30,94 @@ typedef retro_time_t Time;
 
 /**
  * Returns the current CPU time in microseconds.
+ *
+ * Only meant to measure how long the CPU spent on something (profiling, budgets),
+ * use getTimeUsec() for anything that moves with time.
  */
 inline Time getCPUTimeUsec()
 {
     return cpu_features_get_time_usec();
 }
 
+// Source of the time seen by the library: tickings, animations, timers,
+// delays, input timestamps...
+// The system clock is used by default, replace it with a ManualClock
+// to step frames deterministically (tests, benchmarks).
+class Clock
+{
+  public:
+    virtual ~Clock() = default;
+
+    /**
+     * Returns the current time in microseconds.
+     */
+    virtual Time now() = 0;
+
+    /**
+     * Returns the clock currently used by the library.
+     */
+    static Clock* getCurrent();
+
+    /**
+     * Sets the clock used by the library, nullptr goes back to the system clock.
+     * The clock is not owned by the library and must outlive its use.
+     *
+     * Pending timers are moved to the new clock, with the same time left
+     * before their deadline.
+     */
+    static void setCurrent(Clock* clock);
+
+    /**
+     * Returns a number incremented every time the clock is replaced.
+     * Time can go backwards or jump when it changes.
+     */
+    static unsigned getGeneration();
+
+  private:
+    inline static std::atomic<Clock*> current      = nullptr;
+    inline static std::atomic<unsigned> generation = 1;
+};
+
+// Clock following the CPU time
+class SystemClock : public Clock
+{
+  public:
+    Time now() override
+    {
+        return getCPUTimeUsec();
+    }
+};
+
+// Clock that only moves when told to
+class ManualClock : public Clock
+{
+  public:
+    ManualClock(Time time = 0);
+
+    Time now() override;
+
+    /**
+     * Moves the clock forward by the given amount of microseconds.
+     */
+    void advance(Time usec);
+
+    /**
+     * Sets the current time of the clock, in microseconds.
+     */
+    void setTime(Time usec);
+
+  private:
+    std::atomic<Time> time;
+};
+
+/**
+ * Returns the current time in microseconds, as given by the current clock.
+ */
+inline Time getTimeUsec()
+{
+    return Clock::getCurrent()->now();
+}
+
 typedef std::function<void()> TickingGenericCallback;
 
 typedef std::function<void(bool)> TickingEndCallback;
@@ -44,9 +127,17 @@ typedef TickingGenericCallback TickingTickCallback;
 // like a timer, an animation, a background task...
 // The library manages a list of running tickings. Each ticking is reponsible for managing its own
 // lifetime by returning true or false in onUpdate.
+// Running tickings are linked together through the tickings themselves, so that starting
+// and stopping them never allocates nor searches the list.
 class Ticking
 {
   public:
+    Ticking() = default;
+
+    // Running tickings are linked together, a copy would share the links
+    Ticking(const Ticking&) = delete;
+    Ticking& operator=(const Ticking&) = delete;
+
     virtual ~Ticking();
 
     /**
@@ -89,7 +180,16 @@ class Ticking
      */
     static void updateTickings();
 
-    inline static std::vector<Ticking*> runningTickings;
+    /**
+     * Returns the time difference in ms between the last frame
+     * and the current one, as given to every ticking this frame.
+     */
+    static Time getFrameDelta();
+
+    /**
+     * Returns the amount of running tickings.
+     */
+    static size_t getRunningCount();
 
   protected:
     /**
@@ -116,8 +216,24 @@ class Ticking
   private:
     void stop(bool finished);
 
+    inline static Time frameDelta = 0;
+
+    inline static Ticking* firstRunning = nullptr;
+    inline static Ticking* lastRunning  = nullptr;
+    inline static Ticking* nextToUpdate = nullptr; // next ticking updated by updateTickings()
+    inline static size_t runningCount   = 0;
+
+    inline static unsigned long updateCount = 0;
+    inline static bool updating             = false;
+
     bool running = false;
 
+    Ticking* previousRunning = nullptr;
+    Ticking* nextRunning     = nullptr;
+
+    // Update during which the ticking was started, to wait for the next one
+    unsigned long startUpdate = 0;
+
     TickingEndCallback endCallback   = [](bool finished) {};
     TickingTickCallback tickCallback = [] {};
 };
@@ -16,76 +16,141 @@
 
 #pragma once
 
+#include <borealis/core/scheduler.hpp>
 #include <borealis/core/time.hpp>
 
 namespace brls
 {
 
+// Base class of the timers, backed by the Scheduler instead of being
+// updated every frame like the other tickings
+class ScheduledTimer
+{
+  public:
+    ScheduledTimer() = default;
+
+    // A copy would share the handle of the scheduled timer
+    ScheduledTimer(const ScheduledTimer&) = delete;
+    ScheduledTimer& operator=(const ScheduledTimer&) = delete;
+
+    virtual ~ScheduledTimer();
+
+    /**
+     * Starts the timer.
+     * If the timer is already running, this method will have no effect.
+     */
+    void start();
+
+    /**
+     * Stops the timer if it was running, and executes the end callback.
+     */
+    void stop();
+
+    /**
+     * Sets a callback to be executed when the timer stops.
+     * The callback argument will be set to true if the timer stopped
+     * on its own, false if it was stopped early by the user.
+     */
+    void setEndCallback(TickingEndCallback endCallback);
+
+    /**
+     * Returns true if the timer is currently running.
+     */
+    bool isRunning();
+
+  protected:
+    /**
+     * Returns the time to wait before the timer fires, in ms.
+     */
+    virtual Time getDelay() = 0;
+
+    /**
+     * Called when the timer fires. Must return true if the
+     * timer should be scheduled again.
+     */
+    virtual bool onFire() = 0;
+
+    void stop(bool finished);
+
+    // Schedules the timer again from now
+    void reschedule();
+
+  private:
+    void schedule();
+
+    bool running = false;
+    TimerHandle handle;
+
+    TickingEndCallback endCallback = [](bool finished) {};
+};
+
 // A Timer allows to run a callback once after a given period of time, in ms
 // Add the callback with setEndCallback(), set the duration with setDuration() then start the timer
-class Timer : public FiniteTicking
+class Timer : public ScheduledTimer
 {
   public:
+    using ScheduledTimer::start;
+
     /**
      * Starts the timer directly with a given duration, in ms.
      */
     void start(Time duration);
 
-    /**
-     * Starts the timer with the already set duration.
-     */
-    void start();
-
     /**
      * Sets the duration of the timer, in ms.
      * Does not stop or reset it.
      */
     void setDuration(Time duration);
 
-    void onStart() override;
-    bool onUpdate(Time delta) override;
-    void onReset() override;
-    void onRewind() override;
+    /**
+     * Restarts the timer from the beginning if it is running,
+     * without losing its duration.
+     * Does not start or stop it.
+     */
+    void rewind();
+
+    /**
+     * Stops the timer and clears its duration.
+     */
+    void reset();
 
   protected:
+    Time getDelay() override;
+    bool onFire() override;
+
     Time duration = 0;
-    Time progress = 0;
 };
 
 // A RepeatingTimer allows to run a callback repeatedly at a given time interval, in ms
 // Add the callback with setCallback(), set the period with setPeriod() then start the timer
-class RepeatingTimer : public Ticking
+class RepeatingTimer : public ScheduledTimer
 {
   public:
+    using ScheduledTimer::start;
+
     /**
      * Starts the timer directly with a given period, in ms.
      */
     void start(Time period);
 
-    /**
-     * Starts the timer with the already set period.
-     */
-    void start();
-
     /**
      * Sets the period of the timer, in ms.
-     * Does not stop or reset it.
+     * Does not stop or reset it, the new period is used
+     * from the next run of the callback.
      */
     void setPeriod(Time period);
 
     /**
      * Sets the callback of the timer.
-     * Tick callback is still executed every tick.
      * End callback is executed when the timer is stopped.
      */
     void setCallback(TickingGenericCallback callback);
 
-    void onStart() override;
-    bool onUpdate(Time delta) override;
-
   protected:
-    Time period   = 0;
-    Time progress = 0;
+    Time getDelay() override;
+    bool onFire() override;
+
+    Time period = 0;
 
     TickingGenericCallback callback = [] {};
 };
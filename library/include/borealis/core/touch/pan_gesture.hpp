@@ -30,6 +30,16 @@ struct PanAcceleration
 
     // times to cover the distance
     Point time;
+
+    // release velocity in pixels per second
+    Point velocity;
+};
+
+// Timestamped position used to estimate the pan velocity
+struct PanSample
+{
+    Point position;
+    Time timestamp; // CPU time in microseconds
 };
 
 // Current status of gesture
@@ -84,8 +94,14 @@ class PanGestureRecognizer : public GestureRecognizer
     Point startPosition;
     Point delta;
     PanAxis axis;
-    std::vector<Point> posHistory;
+    std::vector<PanSample> posHistory;
     GestureState lastState;
+
+    void addSample(Point position, Time timestamp);
+
+    // Least-squares velocity fit over the samples recorded
+    // during the velocity window preceding the given time
+    Point estimateVelocity(Time now);
 };
 
 } // namespace brls
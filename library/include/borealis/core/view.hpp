@@ -30,9 +30,12 @@
 #include <borealis/core/geometry.hpp>
 #include <borealis/core/gesture.hpp>
 #include <borealis/core/util.hpp>
+#include <borealis/core/view_index.hpp>
+#include <borealis/core/view_pool.hpp>
+#include <borealis/core/xml_attributes.hpp>
+#include <borealis/core/xml_template.hpp>
 #include <functional>
 #include <memory>
-#include <set>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -42,9 +45,22 @@
 // otherwise clang-format will screw it up
 #define BRLS_REGISTER_ENUM_XML_ATTRIBUTE(name, enumType, method, ...)                    \
     this->registerStringXMLAttribute(name, [this](std::string value) {                   \
-        std::unordered_map<std::string, enumType> enumMap = __VA_ARGS__;                 \
-        if (enumMap.count(value) > 0)                                                    \
-            method(enumMap[value]);                                                      \
+        static const std::unordered_map<std::string, enumType> enumMap = __VA_ARGS__;    \
+        auto it = enumMap.find(value);                                                   \
+        if (it != enumMap.end())                                                         \
+            method(it->second);                                                          \
+        else                                                                             \
+            fatal("Illegal value \"" + value + "\" for XML attribute \"" + name + "\""); \
+    })
+
+// Same as BRLS_REGISTER_ENUM_XML_ATTRIBUTE, but registers the attribute in the given
+// class XMLAttributes table, with a method of the class (&Box::setAxis) as handler
+#define BRLS_REGISTER_CLASS_ENUM_XML_ATTRIBUTE(attributes, name, enumType, method, ...)  \
+    attributes.registerString(name, [](auto* view, std::string value) {                  \
+        static const std::unordered_map<std::string, enumType> enumMap = __VA_ARGS__;    \
+        auto it = enumMap.find(value);                                                   \
+        if (it != enumMap.end())                                                         \
+            (view->*(method))(it->second);                                               \
         else                                                                             \
             fatal("Illegal value \"" + value + "\" for XML attribute \"" + name + "\""); \
     })
@@ -196,6 +212,74 @@ typedef std::function<void(std::string)> FilePathAttributeHandler;
  */
 float ntz(float value);
 
+// Retained deletion token of a view, tells whether the view
+// was deleted since the token was retained
+// See View::retainDeletionToken()
+struct DeletionToken
+{
+    View* view   = nullptr;
+    bool* token  = nullptr;
+    int* counter = nullptr;
+};
+
+// Rarely used state of a view: focus and click animations, line, border
+// and shadow settings, actions, gestures, XML bookkeeping...
+//
+// Most views never touch any of it, so it lives in a separate allocation
+// that is only made the first time one of its fields is written,
+// keeping the fields read on every frame packed together in the view.
+struct ViewExtras
+{
+    BRLS_POOLED_CLASS(ViewExtras)
+
+    Animatable highlightAlpha = 0.0f;
+    Animatable clickAlpha     = 0.0f; // animated between 0 and 1
+
+    bool highlightShaking                  = false;
+    Time highlightShakeStart               = 0;
+    FocusDirection highlightShakeDirection = FocusDirection::UP;
+    float highlightShakeAmplitude          = 0.0f;
+
+    Theme* themeOverride = nullptr;
+
+    enum Sound focusSound = SOUND_FOCUS_CHANGE;
+
+    bool hideHighlightBackground = false;
+    bool hideHighlightBorder     = false;
+    bool hideHighlight           = false;
+    bool hideClickAnimation      = false;
+
+    Point detachedOrigin;
+
+    std::vector<Action> actions;
+    std::vector<GestureRecognizer*> gestureRecognizers;
+
+    std::vector<tinyxml2::XMLDocument*> boundDocuments;
+    std::vector<std::unique_ptr<XMLTemplate>> boundTemplates;
+
+    std::unique_ptr<XMLAttributeTable> ownXMLAttributes; // only created if attributes are registered on this instance
+    std::unordered_map<std::string, std::string> themedColorAttributes; // color attribute -> theme color, applied again on theme change
+
+    unsigned maximumAllowedXMLElements = UINT_MAX;
+
+    NVGcolor lineColor = TRANSPARENT;
+    float lineTop      = 0;
+    float lineRight    = 0;
+    float lineBottom   = 0;
+    float lineLeft     = 0;
+
+    NVGcolor borderColor  = TRANSPARENT;
+    float borderThickness = 0.0f;
+    float cornerRadius    = 0.0f;
+    ShadowType shadowType = ShadowType::NONE;
+    bool showShadow       = true;
+
+    std::unordered_map<FocusDirection, std::string> customFocusById;
+    std::unordered_map<FocusDirection, View*> customFocusByPtr;
+
+    AppletFrameItem appletFrameItem;
+};
+
 // Superclass for all the other views
 // Lifecycle of a view is :
 //   new -> [willAppear -> willDisappear] -> delete
@@ -207,9 +291,9 @@ float ntz(float value);
 // before deletion (in case of a TabLayout for instance)
 class View
 {
-  private:
-    ViewBackground background = ViewBackground::NONE;
+    BRLS_POOLED_CLASS(View)
 
+  private:
     void drawBackground(NVGcontext* vg, FrameContext* ctx, Style style);
     void drawShadow(NVGcontext* vg, FrameContext* ctx, Style style, Rect frame);
     void drawBorder(NVGcontext* vg, FrameContext* ctx, Style style, Rect frame);
@@ -218,42 +302,46 @@ class View
     void drawWireframe(FrameContext* ctx, Rect frame);
     void drawLine(FrameContext* ctx, Rect frame);
 
-    Animatable highlightAlpha   = 0.0f;
-    float highlightPadding      = 0.0f;
-    float highlightCornerRadius = 0.0f;
-
-    Animatable clickAlpha = 0.0f; // animated between 0 and 1
+    std::unique_ptr<ViewExtras> extras;
 
-    bool highlightShaking = false;
-    Time highlightShakeStart;
-    FocusDirection highlightShakeDirection;
-    float highlightShakeAmplitude;
+    inline static const ViewExtras defaultExtras;
 
-    bool fadeIn          = false; // is the fade in animation running?
-    bool inFadeAnimation = false; // is any fade animation running?
+    std::unique_ptr<ViewIndex> treeIndex; // only kept by root views with IDs in their tree, see ViewIndex
 
-    Theme* themeOverride = nullptr;
+    /**
+     * Returns the rarely used state of the view, allocating it
+     * if it doesn't exist yet. Only use it to write to the state.
+     */
+    ViewExtras& getExtras();
 
-    bool hidden    = false;
-    bool focusable = false;
+    /**
+     * Returns the rarely used state of the view, or the default state
+     * if it was never allocated. Never allocates.
+     */
+    const ViewExtras& readExtras() const
+    {
+        return this->extras ? *this->extras : View::defaultExtras;
+    }
 
-    enum Sound focusSound = SOUND_FOCUS_CHANGE;
+    /**
+     * Returns the ID index of the tree the view belongs to, kept by the
+     * root view. Returns nullptr if there is none and create is false.
+     */
+    ViewIndex* getTreeIndex(bool create);
 
-    bool hideHighlightBackground = false;
-    bool hideHighlightBorder     = false;
-    bool hideHighlight           = false;
-    bool hideClickAnimation      = false;
+    // Adds or removes the view and its descendants to / from the given index
+    void indexTree(ViewIndex* index, bool add);
 
-    bool detached = false;
-    Point detachedOrigin;
+    // Moves the IDs of the view tree to the index of its new tree
+    void moveTreeIndex(Box* oldParent);
 
-    Point translation;
+    // Tree search of getView(), used when the index has multiple views with the same ID
+    View* searchView(const std::string& id);
 
-    bool wireframeEnabled = false;
-    bool clipsToBounds    = false;
+    const XMLAttributeTable* xmlAttributes = nullptr; // table of the class, or the one in extras
 
-    std::vector<Action> actions;
-    std::vector<GestureRecognizer*> gestureRecognizers;
+    NVGcolor backgroundColor = TRANSPARENT;
+    Point translation;
 
     /**
      * Parent user data, typically the index of the view
@@ -261,47 +349,27 @@ class View
      */
     void* parentUserdata = nullptr;
 
-    bool culled = true; // will be culled by the parent Box, if any
-
-    std::vector<tinyxml2::XMLDocument*> boundDocuments;
-
-    std::unordered_map<std::string, AutoAttributeHandler> autoAttributes;
-    std::unordered_map<std::string, FloatAttributeHandler> percentageAttributes;
-    std::unordered_map<std::string, FloatAttributeHandler> floatAttributes;
-    std::unordered_map<std::string, StringAttributeHandler> stringAttributes;
-    std::unordered_map<std::string, ColorAttributeHandler> colorAttributes;
-    std::unordered_map<std::string, BoolAttributeHandler> boolAttributes;
-    std::unordered_map<std::string, FilePathAttributeHandler> filePathAttributes;
-
-    std::set<std::string> knownAttributes;
-
-    void registerCommonAttributes();
-    void printXMLAttributeErrorMessage(tinyxml2::XMLElement* element, std::string name, std::string value);
-
-    unsigned maximumAllowedXMLElements = UINT_MAX;
-
-    NVGcolor lineColor = TRANSPARENT;
-    float lineTop      = 0;
-    float lineRight    = 0;
-    float lineBottom   = 0;
-    float lineLeft     = 0;
+    float highlightPadding      = 0.0f;
+    float highlightCornerRadius = 0.0f;
 
-    Visibility visibility = Visibility::VISIBLE;
+    ViewBackground background = ViewBackground::NONE;
+    Visibility visibility     = Visibility::VISIBLE;
 
-    NVGcolor backgroundColor = TRANSPARENT;
+    int ptrLockCounter = 0;
 
-    NVGcolor borderColor  = TRANSPARENT;
-    float borderThickness = 0.0f;
-    float cornerRadius    = 0.0f;
-    ShadowType shadowType = ShadowType::NONE;
-    bool showShadow       = true;
+    bool fadeIn          = false; // is the fade in animation running?
+    bool inFadeAnimation = false; // is any fade animation running?
 
-    std::unordered_map<FocusDirection, std::string> customFocusById;
-    std::unordered_map<FocusDirection, View*> customFocusByPtr;
+    bool hidden    = false;
+    bool focusable = false;
+    bool detached  = false;
+    bool culled    = true; // will be culled by the parent Box, if any
 
-    AppletFrameItem appletFrameItem;
+    bool wireframeEnabled = false;
+    bool clipsToBounds    = false;
 
-    int ptrLockCounter = 0;
+    XMLAttributeTable* getOwnXMLAttributes();
+    void printXMLAttributeErrorMessage(tinyxml2::XMLElement* element, std::string name, std::string value);
 
   protected:
     Animatable collapseState = 1.0f;
@@ -350,6 +418,15 @@ class View
         return false;
     }
 
+    /**
+     * Makes the view use the XML attributes of the given class table.
+     *
+     * To be called at the beginning of the constructor of every view class
+     * that has its own XML attributes, with the table returned by its
+     * static getXMLAttributeTable() method.
+     */
+    void setXMLAttributeTable(const XMLAttributeTable* table);
+
   public:
     static constexpr float AUTO = NAN;
 
@@ -389,7 +466,8 @@ class View
      * Returns the view with the corresponding id in the view or its children,
      * or nullptr if it hasn't been found.
      *
-     * Research is done recursively by traversing the tree starting from this view.
+     * The view is looked up in the ID index of the tree, only the first view in tree
+     * order is searched for when there are multiple views with that ID in the tree.
      * This view's parents are not traversed.
      */
     virtual View* getView(std::string id);
@@ -684,6 +762,14 @@ class View
      */
     void setId(std::string id);
 
+    /**
+     * Returns the id of the view, empty if it doesn't have one.
+     */
+    const std::string& getId() const
+    {
+        return this->id;
+    }
+
     /**
      * Overrides align items of the parent box.
      *
@@ -703,7 +789,7 @@ class View
      */
     inline void setLineColor(NVGcolor color)
     {
-        this->lineColor = color;
+        this->getExtras().lineColor = color;
     }
 
     /**
@@ -714,7 +800,7 @@ class View
      */
     inline void setLineTop(float thickness)
     {
-        this->lineTop = thickness;
+        this->getExtras().lineTop = thickness;
     }
 
     /**
@@ -725,7 +811,7 @@ class View
      */
     inline void setLineRight(float thickness)
     {
-        this->lineRight = thickness;
+        this->getExtras().lineRight = thickness;
     }
 
     /**
@@ -736,7 +822,7 @@ class View
      */
     inline void setLineBottom(float thickness)
     {
-        this->lineBottom = thickness;
+        this->getExtras().lineBottom = thickness;
     }
 
     /**
@@ -747,7 +833,7 @@ class View
      */
     inline void setLineLeft(float thickness)
     {
-        this->lineLeft = thickness;
+        this->getExtras().lineLeft = thickness;
     }
 
     /**
@@ -764,7 +850,7 @@ class View
      */
     inline void setBorderColor(NVGcolor color)
     {
-        this->borderColor = color;
+        this->getExtras().borderColor = color;
     }
 
     /**
@@ -772,12 +858,12 @@ class View
      */
     inline void setBorderThickness(float thickness)
     {
-        this->borderThickness = thickness;
+        this->getExtras().borderThickness = thickness;
     }
 
     inline float getBorderThickness()
     {
-        return this->borderThickness;
+        return this->readExtras().borderThickness;
     }
 
     /**
@@ -786,12 +872,12 @@ class View
      */
     inline void setCornerRadius(float radius)
     {
-        this->cornerRadius = radius;
+        this->getExtras().cornerRadius = radius;
     }
 
     inline float getCornerRadius()
     {
-        return this->cornerRadius;
+        return this->readExtras().cornerRadius;
     }
 
     /**
@@ -800,7 +886,7 @@ class View
      */
     inline void setShadowType(ShadowType type)
     {
-        this->shadowType = type;
+        this->getExtras().shadowType = type;
     }
 
     /**
@@ -808,7 +894,7 @@ class View
      */
     inline void setShadowVisibility(bool visible)
     {
-        this->showShadow = visible;
+        this->getExtras().showShadow = visible;
     }
 
     /**
@@ -817,7 +903,7 @@ class View
      */
     inline void setHideHighlightBackground(bool hide)
     {
-        this->hideHighlightBackground = hide;
+        this->getExtras().hideHighlightBackground = hide;
     }
 
     /**
@@ -825,7 +911,7 @@ class View
      */
     inline void setHideHighlightBorder(bool hide)
     {
-        this->hideHighlightBorder = hide;
+        this->getExtras().hideHighlightBorder = hide;
     }
 
     /**
@@ -833,12 +919,12 @@ class View
      */
     inline void setHideHighlight(bool hide)
     {
-        this->hideHighlight = hide;
+        this->getExtras().hideHighlight = hide;
     }
 
     inline void setHideClickAnimation(bool hide)
     {
-        this->hideClickAnimation = hide;
+        this->getExtras().hideClickAnimation = hide;
     }
 
     /**
@@ -865,8 +951,8 @@ class View
      * been found. "Nearest" means the closest in the vicinity
      * of this view. The siblings are searched as well as its children.
      *
-     * Research is done by traversing the tree upwards, starting from this view.
-     * The current algorithm is very inefficient.
+     * Research is done by traversing the tree upwards, starting from this view,
+     * and looking at the views with that ID in the ID index of the tree.
      */
     virtual View* getNearestView(std::string id);
 
@@ -878,8 +964,14 @@ class View
      * Uses the internal lookup table to instantiate the views.
      * Use registerXMLView() to add your own views to the table so that
      * you can use them in your own XML files.
+     *
+     * By default the parsed XML is owned by the view and freed along with it.
+     * Set cache to true for constant layouts created many times: the parsed XML
+     * is then cached for the whole application lifetime, keyed by its content,
+     * so that creating the view again doesn't parse anything.
+     * The cache is never evicted, don't use it for XML generated at runtime.
      */
-    static View* createFromXMLString(std::string xml);
+    static View* createFromXMLString(std::string xml, bool cache = false);
 
     /**
      * Creates a view from the given XML element (node and attributes).
@@ -892,6 +984,13 @@ class View
      */
     static View* createFromXMLElement(tinyxml2::XMLElement* element);
 
+    /**
+     * Creates a view from the given XML element and applies its attributes,
+     * leaving the children elements to the caller. createFromXMLElement() is the
+     * same as calling this method, then handleXMLElements() on the result.
+     */
+    static View* createFromXMLElementWithoutChildren(tinyxml2::XMLElement* element);
+
     /**
      * Creates a view from the given XML file path.
      *
@@ -925,6 +1024,12 @@ class View
      */
     virtual void handleXMLElement(tinyxml2::XMLElement* element);
 
+    /**
+     * Calls handleXMLElement() for every child of the given XML element,
+     * refusing more children than getMaximumAllowedXMLElements().
+     */
+    void handleXMLElements(tinyxml2::XMLElement* element);
+
     /**
      * Applies the attributes of the given XML element to the view.
      *
@@ -937,15 +1042,32 @@ class View
      * Applies the given attribute to the view.
      *
      * You can add your own attributes to by calling registerXMLAttribute()
-     * in the view constructor.
+     * in the view constructor. Attributes of views inflated from XML all
+     * go through this method, the default implementation parses the value
+     * and calls applyXMLAttributeValue().
      */
     virtual bool applyXMLAttribute(std::string name, std::string value);
 
+    /**
+     * Applies the given parsed attribute value to the view.
+     */
+    virtual bool applyXMLAttributeValue(const std::string& name, const XMLValue& value);
+
+    /**
+     * Calls applyXMLAttribute() with the raw string of the given
+     * value. It is not parsed again unless the string is changed
+     * by an override before reaching applyXMLAttributeValue().
+     */
+    bool applyParsedXMLAttribute(const std::string& name, const XMLValue& value);
+
     /**
      * Register a new XML attribute with the given name and handler
      * method. You can have multiple attributes registered with the same
      * name but different types / handlers, except if the type is string.
      *
+     * The attribute is only registered on that instance. View classes should
+     * register theirs once in their class table instead (see getXMLAttributeTable()).
+     *
      * The method will be called if the attribute has the value "auto".
      */
     void registerAutoXMLAttribute(std::string name, AutoAttributeHandler handler);
@@ -955,6 +1077,9 @@ class View
      * method. You can have multiple attributes registered with the same
      * name but different types / handlers, except if the type is string.
      *
+     * The attribute is only registered on that instance. View classes should
+     * register theirs once in their class table instead (see getXMLAttributeTable()).
+     *
      * The method will be called if the attribute has a percentage value (an integer with "%" suffix).
      * The given float value is guaranteed to be between 0.0f and 1.0f.
      */
@@ -965,6 +1090,9 @@ class View
      * method. You can have multiple attributes registered with the same
      * name but different types / handlers, except if the type is string.
      *
+     * The attribute is only registered on that instance. View classes should
+     * register theirs once in their class table instead (see getXMLAttributeTable()).
+     *
      * The method will be called if the attribute has an integer, float, @style or "px" value.
      */
     void registerFloatXMLAttribute(std::string name, FloatAttributeHandler handler);
@@ -974,6 +1102,9 @@ class View
      * method. You can have multiple attributes registered with the same
      * name but different types / handlers, except if the type is string.
      *
+     * The attribute is only registered on that instance. View classes should
+     * register theirs once in their class table instead (see getXMLAttributeTable()).
+     *
      * The method will be called if the attribute has a string or @i18n value.
      *
      * If you use string as a type, you can only have one handler for the attribute.
@@ -985,6 +1116,9 @@ class View
      * method. You can have multiple attributes registered with the same
      * name but different types / handlers, except if the type is string.
      *
+     * The attribute is only registered on that instance. View classes should
+     * register theirs once in their class table instead (see getXMLAttributeTable()).
+     *
      * The method will be called if the attribute has a color value ("#XXXXXX" or "#XXXXXXXX")
      * or a @theme value.
      */
@@ -995,6 +1129,9 @@ class View
      * method. You can have multiple attributes registered with the same
      * name but different types / handlers, except if the type is string.
      *
+     * The attribute is only registered on that instance. View classes should
+     * register theirs once in their class table instead (see getXMLAttributeTable()).
+     *
      * The method will be called if the attribute has a boolean value ("true" or "false").
      */
     void registerBoolXMLAttribute(std::string name, BoolAttributeHandler handler);
@@ -1004,16 +1141,34 @@ class View
      * method. You can have multiple attributes registered with the same
      * name but different types / handlers, except if the type is string.
      *
+     * The attribute is only registered on that instance. View classes should
+     * register theirs once in their class table instead (see getXMLAttributeTable()).
+     *
      * The method will be called if the attribute has a file path value ("@res/" or raw path).
      */
     void registerFilePathXMLAttribute(std::string name, FilePathAttributeHandler handler);
 
+    /**
+     * Returns the XML attributes shared by all views: sizing, margins,
+     * shape, visibility... Tables of derived classes start from this one.
+     */
+    static const XMLAttributeTable* getXMLAttributeTable();
+
     /**
      * Binds the given XML document to the view for ownership. The
      * document will then be deleted when the view is.
+     *
+     * Views created or inflated from XML don't need it: their
+     * document is kept in the XMLTemplate cache.
      */
     void bindXMLDocument(tinyxml2::XMLDocument* document);
 
+    /**
+     * Binds the given uncached XML template to the view for ownership.
+     * The template will then be deleted when the view is.
+     */
+    void bindXMLTemplate(std::unique_ptr<XMLTemplate> xmlTemplate);
+
     /**
      * Returns if the given XML attribute name is valid for that view.
      */
@@ -1055,7 +1210,7 @@ class View
      */
     inline void setFocusSound(enum Sound sound)
     {
-        this->focusSound = sound;
+        this->getExtras().focusSound = sound;
     }
 
     virtual enum Sound getFocusSound();
@@ -1094,13 +1249,24 @@ class View
      */
     Point getDetachedPosition() const
     {
-        return detachedOrigin;
+        return this->readExtras().detachedOrigin;
     }
 
     void setParent(Box* parent, void* parentUserdata = nullptr);
     Box* getParent();
     bool hasParent();
 
+    /**
+     * Returns the root of the tree the view belongs to,
+     * the view itself if it doesn't have a parent.
+     */
+    View* getRoot();
+
+    /**
+     * Returns true if the given view is one of the descendants of this view.
+     */
+    bool isAncestorOf(View* view);
+
     void* getParentUserData();
 
     /**
@@ -1165,7 +1331,7 @@ class View
 
     const std::vector<Action>& getActions()
     {
-        return this->actions;
+        return this->readExtras().actions;
     }
 
     /**
@@ -1173,7 +1339,7 @@ class View
      */
     const std::vector<GestureRecognizer*>& getGestureRecognizers()
     {
-        return this->gestureRecognizers;
+        return this->readExtras().gestureRecognizers;
     }
 
     /**
@@ -1384,6 +1550,12 @@ class View
         // Nothing by default
     }
 
+    /**
+     * Fired when the application theme changes. Applies again
+     * the color attributes that were set from the theme.
+     */
+    virtual void onThemeChanged();
+
     GenericEvent* getFocusEvent();
 
     Animatable alpha = 1.0f;
@@ -1452,9 +1624,27 @@ class View
      */
     static std::string getFilePathXMLAttributeValue(std::string value);
 
+    /**
+     * Retains the deletion token of this view, to know later on whether
+     * the view was deleted in the meantime. Same as ASYNC_RETAIN, usable
+     * from outside of the view.
+     *
+     * Must be called on the main thread, and balanced by a call to
+     * releaseDeletionToken() on the main thread.
+     */
+    DeletionToken retainDeletionToken();
+
+    /**
+     * Releases a token given by retainDeletionToken(). Same as ASYNC_RELEASE.
+     * Returns true if the view is still alive.
+     *
+     * Must be called on the main thread.
+     */
+    static bool releaseDeletionToken(DeletionToken token);
+
     AppletFrameItem *getAppletFrameItem()
     {
-        return &this->appletFrameItem;
+        return &this->getExtras().appletFrameItem;
     }
 
     void updateAppletFrameItem();
@@ -0,0 +1,60 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace brls
+{
+
+class View;
+
+// Views of a tree that have an ID, indexed by the hash of their ID
+//
+// Every root view (view without a parent) keeps the index of its tree, updated as
+// views are added to or removed from the tree and as they are given an ID, so that
+// View::getView() and View::getNearestView() don't have to search the whole tree.
+class ViewIndex
+{
+  public:
+    void add(View* view);
+    void remove(View* view);
+
+    /**
+     * Moves every view of the given index into this one.
+     */
+    void merge(ViewIndex* other);
+
+    /**
+     * Returns the views that may have the given ID (with the same hash,
+     * the ID itself must still be compared), or nullptr if there is none.
+     */
+    const std::vector<View*>* find(const std::string& id) const;
+
+    bool isEmpty() const
+    {
+        return this->views.empty();
+    }
+
+  private:
+    std::unordered_map<uint64_t, std::vector<View*>> views;
+};
+
+} // namespace brls
@@ -0,0 +1,147 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+// Makes the class allocate its instances from the ViewPool, and count them
+// under its name in the pool statistics
+// Subclasses that don't use the macro are allocated by the pool too, using
+// their real size, but are counted under the nearest pooled parent class
+// The placement and nothrow forms are declared as well, as declaring the
+// sized operators in the class hides the global ones
+#define BRLS_POOLED_CLASS(className)                                                        \
+  public:                                                                                   \
+    static void* operator new(size_t size)                                                  \
+    {                                                                                       \
+        return brls::ViewPool::allocate(size, className::getPoolStats());                   \
+    }                                                                                       \
+                                                                                            \
+    static void operator delete(void* ptr, size_t size)                                     \
+    {                                                                                       \
+        brls::ViewPool::deallocate(ptr, size, className::getPoolStats());                   \
+    }                                                                                       \
+                                                                                            \
+    static void* operator new(size_t size, const std::nothrow_t&) noexcept                  \
+    {                                                                                       \
+        try                                                                                 \
+        {                                                                                   \
+            return brls::ViewPool::allocate(size, className::getPoolStats());               \
+        }                                                                                   \
+        catch (...)                                                                         \
+        {                                                                                   \
+            return nullptr;                                                                 \
+        }                                                                                   \
+    }                                                                                       \
+                                                                                            \
+    /* Only called if the constructor throws, without the real size: */                     \
+    /* a subclass' block is given back as a smaller one, which is safe */                   \
+    static void operator delete(void* ptr, const std::nothrow_t&) noexcept                  \
+    {                                                                                       \
+        brls::ViewPool::deallocate(ptr, sizeof(className), className::getPoolStats());      \
+    }                                                                                       \
+                                                                                            \
+    static void* operator new(size_t size, void* ptr) noexcept                              \
+    {                                                                                       \
+        return ptr;                                                                         \
+    }                                                                                       \
+                                                                                            \
+    static void operator delete(void* ptr, void* place) noexcept { }                        \
+                                                                                            \
+    static brls::ViewPoolClassStats* getPoolStats()                                         \
+    {                                                                                       \
+        static brls::ViewPoolClassStats* stats = brls::ViewPool::registerClass(#className); \
+        return stats;                                                                       \
+    }
+
+namespace brls
+{
+
+// Allocation counters of a pooled class
+struct ViewPoolClassStats
+{
+    const char* name;
+
+    size_t live  = 0; // instances currently allocated
+    size_t peak  = 0; // maximum amount of instances allocated at once
+    size_t total = 0; // instances allocated since the start of the application
+};
+
+// Slab allocator for views and their side allocations
+//
+// Objects are sorted by size classes. Each size class carves its objects
+// from slabs of contiguous memory and keeps freed objects in a free list,
+// so creating and deleting the same views over and over (recycler cells,
+// dialogs...) reuses the same memory instead of fragmenting the heap.
+// Slabs are never given back to the system.
+//
+// Can be used from any thread.
+class ViewPool
+{
+  public:
+    static void* allocate(size_t size, ViewPoolClassStats* stats);
+    static void deallocate(void* ptr, size_t size, ViewPoolClassStats* stats);
+
+    /**
+     * Creates the counters of a pooled class. Use BRLS_POOLED_CLASS instead
+     * of calling this directly.
+     */
+    static ViewPoolClassStats* registerClass(const char* name);
+
+    /**
+     * Returns a snapshot of the counters of every pooled class.
+     */
+    static std::vector<ViewPoolClassStats> getStats();
+
+    /**
+     * Returns the amount of memory reserved in slabs, in bytes.
+     */
+    static size_t getReservedBytes();
+
+    /**
+     * Prints the counters of every pooled class with live instances to the log,
+     * at the info level.
+     */
+    static void dump();
+
+  private:
+    static constexpr size_t GRANULARITY   = 16;
+    static constexpr size_t SIZE_CLASSES  = 128; // objects bigger than 2KB are not pooled
+    static constexpr size_t SLAB_CAPACITY = 32; // objects per slab
+
+    struct FreeObject
+    {
+        FreeObject* next;
+    };
+
+    inline static std::mutex mutex;
+    inline static FreeObject* freeObjects[SIZE_CLASSES] = {};
+    inline static size_t reservedBytes                  = 0;
+    inline static std::vector<ViewPoolClassStats*> classes;
+
+    static size_t getSizeClass(size_t size)
+    {
+        return (size - 1) / GRANULARITY;
+    }
+
+    static void allocateSlab(size_t sizeClass);
+};
+
+} // namespace brls
@@ -0,0 +1,157 @@
+/*
+    Copyright 2021 XITRIX
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <nanovg.h>
+
+#include <borealis/core/interned_key.hpp>
+#include <borealis/core/util.hpp>
+#include <functional>
+#include <string>
+
+namespace brls
+{
+
+class View;
+
+// Handlers of one XML attribute name, one per type of value
+// the attribute accepts. They are given the view to apply the value to.
+struct XMLAttributeHandlers
+{
+    std::function<void(View*)> autoHandler;
+    std::function<void(View*, float)> percentageHandler;
+    std::function<void(View*, float)> floatHandler;
+    std::function<void(View*, std::string)> stringHandler;
+    std::function<void(View*, NVGcolor)> colorHandler;
+    std::function<void(View*, bool)> boolHandler;
+    std::function<void(View*, std::string)> filePathHandler;
+};
+
+// XML attributes of a view class, built once and shared by all its instances
+//
+// A table starts as a copy of the table of the parent class, so that
+// looking up an attribute is a single hash table probe whatever the depth
+// of the class hierarchy. Registering a handler for a name and type that
+// already has one replaces it.
+class XMLAttributeTable
+{
+  public:
+    XMLAttributeTable() = default;
+
+    explicit XMLAttributeTable(const XMLAttributeTable* parent)
+    {
+        if (parent)
+            *this = *parent;
+    }
+
+    /**
+     * Returns the handlers of the given attribute, or nullptr
+     * if the attribute is unknown.
+     */
+    const XMLAttributeHandlers* find(const std::string& name) const
+    {
+        return this->handlers.find(name);
+    }
+
+    /**
+     * Returns the handlers of the given attribute, adding the attribute
+     * to the table if it's not known yet.
+     */
+    XMLAttributeHandlers& get(const std::string& name)
+    {
+        if (!this->handlers.insert(name, XMLAttributeHandlers()))
+            fatal("XML attribute \"" + name + "\" collides with another attribute");
+
+        return *this->handlers.find(name);
+    }
+
+  private:
+    KeyTable<XMLAttributeHandlers> handlers;
+};
+
+// Registers the XML attributes of the view class V in its table
+//
+// Handlers are either methods of V (&Label::setText) or functions
+// taking a V* and the value ([](Label* label, std::string value) { ... }).
+// See View::registerFloatXMLAttribute() and such for what each type accepts.
+template <typename V>
+class XMLAttributes : public XMLAttributeTable
+{
+  public:
+    explicit XMLAttributes(const XMLAttributeTable* parent)
+        : XMLAttributeTable(parent)
+    {
+    }
+
+    template <typename Handler>
+    void registerAuto(const std::string& name, Handler handler)
+    {
+        this->get(name).autoHandler = [handler](View* view) {
+            std::invoke(handler, static_cast<V*>(view));
+        };
+    }
+
+    template <typename Handler>
+    void registerPercentage(const std::string& name, Handler handler)
+    {
+        this->get(name).percentageHandler = [handler](View* view, float value) {
+            std::invoke(handler, static_cast<V*>(view), value);
+        };
+    }
+
+    template <typename Handler>
+    void registerFloat(const std::string& name, Handler handler)
+    {
+        this->get(name).floatHandler = [handler](View* view, float value) {
+            std::invoke(handler, static_cast<V*>(view), value);
+        };
+    }
+
+    template <typename Handler>
+    void registerString(const std::string& name, Handler handler)
+    {
+        this->get(name).stringHandler = [handler](View* view, std::string value) {
+            std::invoke(handler, static_cast<V*>(view), value);
+        };
+    }
+
+    template <typename Handler>
+    void registerColor(const std::string& name, Handler handler)
+    {
+        this->get(name).colorHandler = [handler](View* view, NVGcolor value) {
+            std::invoke(handler, static_cast<V*>(view), value);
+        };
+    }
+
+    template <typename Handler>
+    void registerBool(const std::string& name, Handler handler)
+    {
+        this->get(name).boolHandler = [handler](View* view, bool value) {
+            std::invoke(handler, static_cast<V*>(view), value);
+        };
+    }
+
+    template <typename Handler>
+    void registerFilePath(const std::string& name, Handler handler)
+    {
+        this->get(name).filePathHandler = [handler](View* view, std::string value) {
+            std::invoke(handler, static_cast<V*>(view), value);
+        };
+    }
+};
+
+} // namespace brls
@@ -0,0 +1,197 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <nanovg.h>
+#include <tinyxml2.h>
+
+#include <borealis/core/interned_key.hpp>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace brls
+{
+
+class View;
+
+namespace compiled
+{
+    struct Element;
+}
+
+// Stored in compiled layouts: only add new types at the end
+enum class XMLValueType
+{
+    OTHER, // only usable by string and file path attributes
+    RES, // @res/...
+    AUTO,
+    PIXELS, // ...px
+    PERCENTAGE, // ...%
+    STYLE, // @style/...
+    COLOR, // #RRGGBB or #RRGGBBAA
+    THEME, // @theme/...
+    BOOL,
+    FLOAT,
+    INVALID, // malformed pixels, percentage or color: refused by every non string attribute
+};
+
+// Value of an XML attribute, parsed once
+//
+// The type is the one the value would be given as to a view that
+// doesn't have a string handler for the attribute, see View::applyXMLAttributeValue().
+struct XMLValue
+{
+    XMLValue() = default;
+    explicit XMLValue(std::string value);
+
+    XMLValue(const XMLValue&) = delete;
+    XMLValue& operator=(const XMLValue&) = delete;
+
+    std::string raw;
+
+    bool i18n = false; // is the string an @i18n/ reference?
+    std::string string; // translation name if i18n, raw value otherwise
+
+    XMLValueType type = XMLValueType::OTHER;
+
+    std::string path; // resolved path if RES, raw value otherwise
+
+    float number   = 0.0f; // PIXELS, PERCENTAGE, FLOAT
+    NVGcolor color = {}; // COLOR
+    bool boolean   = false; // BOOL
+
+    std::string keyName; // style metric or theme color name for STYLE and THEME
+    std::unique_ptr<InternedKey> key; // built from keyName, only set for STYLE and THEME
+};
+
+// Attribute of an element of a layout template
+struct XMLTemplateAttribute
+{
+    XMLTemplateAttribute(const char* name, const char* value)
+        : name(name)
+        , value(value)
+    {
+    }
+
+    // The value is left to be filled by the caller
+    explicit XMLTemplateAttribute(const char* name)
+        : name(name)
+    {
+    }
+
+    std::string name;
+    XMLValue value;
+};
+
+// Element of a layout template, attached to its tinyxml2 element as user data
+struct XMLTemplateNode
+{
+    // Creator of the view registered for the tag when the template was compiled,
+    // nullptr if there was none (not a view, or registered later)
+    const std::function<View*(void)>* creator = nullptr;
+
+    std::vector<std::unique_ptr<XMLTemplateAttribute>> attributes;
+};
+
+// Parsed XML layout, shared by every view inflated from the same source
+//
+// Templates are kept for the whole application lifetime, keyed by their source
+// string or file path: inflating the same layout again doesn't load nor parse
+// anything, and views don't need to keep the XML document alive.
+// The cache is never evicted, XML generated at runtime should be parsed with
+// parseString() instead, its template is then owned by the inflated view.
+// Each element of the document carries its XMLTemplateNode, with the attribute
+// values already parsed and the view creator already looked up.
+//
+// Can be used from any thread, the creators looked up while compiling are only called
+// by the main thread when inflating.
+class XMLTemplate
+{
+  public:
+    enum class Source
+    {
+        XML,
+        COMPILED, // see CompiledLayouts
+    };
+
+    /**
+     * Returns the template of the given XML source, parsing it the first time.
+     * Returns nullptr and sets the error if the XML is invalid.
+     *
+     * The template is cached until the application exits, only use it
+     * for constant sources.
+     */
+    static XMLTemplate* fromString(const std::string& xml, tinyxml2::XMLError* error);
+
+    /**
+     * Parses the given XML source without going through the cache,
+     * for one-off sources such as XML generated at runtime.
+     * Returns nullptr and sets the error if the XML is invalid.
+     *
+     * The template must outlive the views inflated from it,
+     * see View::bindXMLTemplate().
+     */
+    static std::unique_ptr<XMLTemplate> parseString(const std::string& xml, tinyxml2::XMLError* error);
+
+    /**
+     * Returns the template of the given XML file, loading it the first time.
+     * Returns nullptr and sets the error if the file cannot be loaded.
+     */
+    static XMLTemplate* fromFile(const std::string& path, tinyxml2::XMLError* error);
+
+    /**
+     * Loads the given file from the given source, without going through the cache.
+     * Returns nullptr if the file cannot be loaded from that source.
+     * Only meant for tools and benchmarks: every call loads the file again.
+     */
+    static std::unique_ptr<XMLTemplate> loadFile(const std::string& path, Source source);
+
+    /**
+     * Returns the template node of the given element, or nullptr if the
+     * element doesn't belong to a template.
+     */
+    static const XMLTemplateNode* getNode(const tinyxml2::XMLElement* element)
+    {
+        return static_cast<const XMLTemplateNode*>(element->GetUserData());
+    }
+
+    tinyxml2::XMLElement* getRoot()
+    {
+        return this->document.RootElement();
+    }
+
+  private:
+    tinyxml2::XMLDocument document;
+    std::vector<std::unique_ptr<XMLTemplateNode>> nodes;
+
+    void compile(tinyxml2::XMLElement* element);
+    void build(const compiled::Element* element, tinyxml2::XMLNode* parent, std::unordered_map<uint32_t, const std::function<View*(void)>*>& creators);
+
+    static XMLTemplate* create(const std::string& source, bool file, bool allowCompiled, tinyxml2::XMLError* error);
+
+    static XMLTemplate* load(std::unordered_map<std::string, XMLTemplate*>& cache, const std::string& key, bool file, tinyxml2::XMLError* error);
+
+    inline static std::mutex cacheMutex;
+    inline static std::unordered_map<std::string, XMLTemplate*> stringCache;
+    inline static std::unordered_map<std::string, XMLTemplate*> fileCache;
+};
+
+} // namespace brls
@@ -52,6 +52,8 @@ class GLFWPlatform : public Platform
     GLFWVideoContext* videoContext = nullptr;
     GLFWInputManager* inputManager = nullptr;
     GLFWFontLoader* fontLoader     = nullptr;
+
+    ThemeVariant themeVariant = ThemeVariant::LIGHT;
 };
 
 } // namespace brls
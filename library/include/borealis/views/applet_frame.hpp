@@ -37,6 +37,8 @@ enum class HeaderStyle
 // A Horizon settings-like frame, with header and footer (no sidebar)
 class AppletFrame : public Box
 {
+    BRLS_POOLED_CLASS(AppletFrame)
+
   public:
     AppletFrame();
     AppletFrame(View* contentView);
@@ -71,6 +73,7 @@ class AppletFrame : public Box
     }
 
     static View* create();
+    static const XMLAttributeTable* getXMLAttributeTable();
 
   private:
     BRLS_BIND(Box, header, "brls/applet_frame/header");
@@ -0,0 +1,126 @@
+/*
+    Copyright 2019-2021 natinusala
+    Copyright 2019 p-sam
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+#pragma once
+
+#include <borealis/core/box.hpp>
+#include <borealis/core/event.hpp>
+#include <borealis/core/time.hpp>
+#include <borealis/views/progress_spinner.hpp>
+#include <vector>
+
+namespace brls
+{
+
+class XMLTemplate;
+
+typedef Event<View*> InflatedEvent;
+
+// A box inflating an XML layout without blocking the main thread, showing
+// a spinner until the layout is ready
+//
+// Inflating is made of two phases. The XML file is first loaded, parsed and
+// its attribute values resolved into an XMLTemplate on a worker thread. The
+// views are then instantiated from the template on the main thread, a few
+// elements per frame within the inflate budget, as views are not thread-safe.
+// The inflated view is only added to the box once complete.
+//
+// Children of plain brls:Box elements are spread across frames, every other
+// element is instantiated with all of its children in one go, since views
+// can handle their children elements however they want.
+class AsyncLayout : public Box
+{
+    BRLS_POOLED_CLASS(AsyncLayout)
+
+  public:
+    AsyncLayout();
+    ~AsyncLayout();
+
+    /**
+     * Loads and inflates the given XML file.
+     */
+    void inflateXMLFileAsync(std::string path);
+
+    /**
+     * Loads and inflates the given XML resource file name.
+     */
+    void inflateXMLResAsync(std::string name);
+
+    /**
+     * Inflates the given XML element, which must belong to a template
+     * that outlives the layout (see XMLTemplate). Only the instantiation
+     * phase is left to do.
+     */
+    void inflateXMLElementAsync(tinyxml2::XMLElement* element);
+
+    /**
+     * Returns true once the inflated view has been added to the box.
+     */
+    bool isInflated();
+
+    /**
+     * Returns the inflated view, or nullptr if it's not ready yet.
+     */
+    View* getInflatedView();
+
+    /**
+     * Fired on the main thread with the inflated view once it's been added to the box.
+     */
+    InflatedEvent* getInflatedEvent();
+
+    /**
+     * Sets the time the main thread can spend instantiating
+     * views every frame, in us.
+     */
+    void setInflateBudget(Time budget);
+
+    static View* create();
+    static const XMLAttributeTable* getXMLAttributeTable();
+
+    static AsyncLayout* createFromXMLFile(std::string path);
+    static AsyncLayout* createFromXMLResource(std::string name);
+
+    static constexpr Time DEFAULT_INFLATE_BUDGET = 4000;
+
+  private:
+    // Element left to instantiate and add to its parent
+    struct PendingElement
+    {
+        Box* parent;
+        tinyxml2::XMLElement* element;
+    };
+
+    ProgressSpinner* spinner = nullptr;
+
+    View* root     = nullptr; // detached until complete
+    View* inflated = nullptr;
+    std::vector<PendingElement> pending; // next one at the back
+
+    Time inflateBudget = DEFAULT_INFLATE_BUDGET;
+    bool started       = false;
+
+    InflatedEvent inflatedEvent;
+
+    void scheduleStep();
+    void step();
+    void instantiate(PendingElement pendingElement);
+    void finish();
+
+    // Loads the templates of the brls:View elements of the given element, on a worker thread
+    static void preloadXMLViews(tinyxml2::XMLElement* element);
+};
+
+} // namespace brls
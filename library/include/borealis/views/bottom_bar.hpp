@@ -19,6 +19,7 @@
 #include <borealis/core/application.hpp>
 #include <borealis/core/bind.hpp>
 #include <borealis/core/box.hpp>
+#include <borealis/core/event.hpp>
 #include <borealis/views/image.hpp>
 #include <borealis/views/label.hpp>
 
@@ -27,9 +28,10 @@ namespace brls
 
 class BottomBar : public Box
 {
+    BRLS_POOLED_CLASS(BottomBar)
+
   public:
     BottomBar();
-    void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) override;
     static View* create();
 
   private:
@@ -37,6 +39,8 @@ class BottomBar : public Box
     BRLS_BIND(Label, time, "brls/hints/time");
     BRLS_BIND(View, battery, "brls/battery");
     BRLS_BIND(View, wireless, "brls/wireless");
+
+    ScopedSubscription timeSubscription;
 };
 
 } // namespace brls
@@ -144,13 +144,17 @@ enum class ButtonState
 // A button
 class Button : public Box
 {
+    BRLS_POOLED_CLASS(Button)
+
   public:
     Button();
 
     void onFocusGained() override;
     void onFocusLost() override;
+    void onThemeChanged() override;
 
     static View* create();
+    static const XMLAttributeTable* getXMLAttributeTable();
 
     /**
      * Sets the style of the button. can be a pointer to one of the
@@ -27,6 +27,8 @@ namespace brls
 
 class BooleanCell : public DetailCell
 {
+    BRLS_POOLED_CLASS(BooleanCell)
+
   public:
     BooleanCell();
 
@@ -43,6 +45,8 @@ class BooleanCell : public DetailCell
         return &event;
     }
 
+    void onThemeChanged() override;
+
     static View* create();
 
   private:
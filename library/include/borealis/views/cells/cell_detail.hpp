@@ -26,6 +26,8 @@ namespace brls
 
 class DetailCell : public RecyclerCell
 {
+    BRLS_POOLED_CLASS(DetailCell)
+
   public:
     DetailCell();
 
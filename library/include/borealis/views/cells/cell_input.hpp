@@ -28,6 +28,8 @@ namespace brls
 
 class InputCell : public DetailCell
 {
+    BRLS_POOLED_CLASS(InputCell)
+
   public:
     InputCell();
 
@@ -60,6 +62,8 @@ class InputCell : public DetailCell
         return &event;
     }
 
+    void onThemeChanged() override;
+
     static View* create();
 
   private:
@@ -75,6 +79,8 @@ class InputCell : public DetailCell
 
 class InputNumericCell : public DetailCell
 {
+    BRLS_POOLED_CLASS(InputNumericCell)
+
   public:
     InputNumericCell();
 
@@ -101,6 +107,8 @@ class InputNumericCell : public DetailCell
         return &event;
     }
 
+    void onThemeChanged() override;
+
     static View* create();
 
   private:
@@ -26,6 +26,8 @@ namespace brls
 
 class CheckBox : public View
 {
+    BRLS_POOLED_CLASS(CheckBox)
+
   public:
     CheckBox();
     virtual void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) override;
@@ -35,12 +37,16 @@ class CheckBox : public View
 
 class RadioCell : public RecyclerCell
 {
+    BRLS_POOLED_CLASS(RadioCell)
+
   public:
     RadioCell();
 
     void setSelected(bool selected);
     bool getSelected();
 
+    void onThemeChanged() override;
+
     BRLS_BIND(Label, title, "brls/rediocell/title");
     BRLS_BIND(CheckBox, checkbox, "brls/rediocell/checkbox");
 
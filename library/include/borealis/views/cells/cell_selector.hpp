@@ -28,6 +28,8 @@ namespace brls
 
 class SelectorCell : public DetailCell
 {
+    BRLS_POOLED_CLASS(SelectorCell)
+
   public:
     SelectorCell();
 
@@ -49,6 +51,8 @@ class SelectorCell : public DetailCell
         return &event;
     }
 
+    void onThemeChanged() override;
+
     static View* create();
 
   private:
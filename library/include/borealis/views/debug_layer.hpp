@@ -23,6 +23,8 @@ namespace brls
 
 class DebugLayer : public Box
 {
+    BRLS_POOLED_CLASS(DebugLayer)
+
   public:
     DebugLayer();
 };
@@ -40,6 +40,8 @@ class DialogButton
 // Create the dialog then use open() and close()
 class Dialog : public Box
 {
+    BRLS_POOLED_CLASS(Dialog)
+
   private:
     BRLS_BIND(Box, container, "brls/dialog/container");
     BRLS_BIND(AppletFrame, appletFrame, "brls/dialog/applet");
@@ -41,6 +41,8 @@ typedef Event<int> ValueSelectedEvent;
 // values
 class Dropdown : public Box, private RecyclerDataSource
 {
+    BRLS_POOLED_CLASS(Dropdown)
+
   private:
     BRLS_BIND(RecyclerFrame, recycler, "brls/dropdown/recycler");
     BRLS_BIND(Box, header, "brls/dropdown/header");
@@ -28,6 +28,8 @@ namespace brls
 // and a separator
 class Header : public Box
 {
+    BRLS_POOLED_CLASS(Header)
+
   public:
     Header();
 
@@ -35,6 +37,7 @@ class Header : public Box
     void setSubtitle(std::string text);
 
     static View* create();
+    static const XMLAttributeTable* getXMLAttributeTable();
 
   private:
     BRLS_BIND(Label, title, "brls/header/title");
@@ -27,19 +27,48 @@ namespace brls
 
 class Hint : public Box
 {
+    BRLS_POOLED_CLASS(Hint)
+
   public:
-    Hint(Action action);
+    Hint(ControllerButton button);
+
+    /**
+     * Shows the given action, which must be bound to the button of the hint.
+     * Only what changed since the last action is updated.
+     */
+    void setAction(const Action& action);
+
+    ControllerButton getButton() const
+    {
+        return this->button;
+    }
+
+    void onThemeChanged() override;
+
     static std::string getKeyIcon(ControllerButton button, bool ignoreKeysSwap = false);
 
   private:
-    Action action;
+    ControllerButton button;
+
+    std::string iconText;
+    std::string hintText;
+    bool enabled = true;
+
+    void applyTextColor();
 
     BRLS_BIND(Label, icon, "icon");
     BRLS_BIND(Label, hint, "hint");
 };
 
+// Hints bar, showing the actions of the focused view and its parents
+//
+// Hints are keyed by button: they are kept from one focus to the other and
+// only updated when their action changes. Hints update events are coalesced
+// into one refresh, made at the beginning of the next frame.
 class Hints : public Box
 {
+    BRLS_POOLED_CLASS(Hints)
+
   public:
     Hints();
     ~Hints();
@@ -55,13 +84,31 @@ class Hints : public Box
     }
 
     static View* create();
+    static const XMLAttributeTable* getXMLAttributeTable();
+
+    /**
+     * Returns the action shown for the given button when the
+     * given view is focused, or nullptr if there is none.
+     */
+    static const Action* findAction(View* focusView, ControllerButton button);
 
   private:
     void refillHints(View* focusView);
     bool addUnabledAButtonAction = true;
 
-    VoidEvent::Subscription hintSubscription;
-    static bool actionsSortFunc(Action a, Action b);
+    Action baseAction; // A action added when there is none
+
+    Hint* hints[_BUTTON_MAX] = {}; // by button, nullptr if never shown
+    std::vector<const Action*> actions; // kept to reuse its storage
+
+    ScopedSubscription hintSubscription;
+
+    static int getActionRank(const Action* action);
+
+    static void scheduleRefresh();
+
+    inline static bool refreshScheduled = false;
+    inline static std::vector<Hints*> instances;
 };
 
 } // namespace brls
@@ -62,6 +62,8 @@ enum class ImageAlignment
 // Supported formats are: JPG, PNG, TGA, BMP and GIF (not animated).
 class Image : public View
 {
+    BRLS_POOLED_CLASS(Image)
+
   public:
     Image();
     ~Image();
@@ -120,6 +122,7 @@ class Image : public View
     float getOriginalImageHeight();
 
     static View* create();
+    static const XMLAttributeTable* getXMLAttributeTable();
 
   private:
     ImageScalingType scalingType     = ImageScalingType::FIT;
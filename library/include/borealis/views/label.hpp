@@ -48,6 +48,8 @@ enum class VerticalAlign
 // Warning: to wrap, the label width MUST be constrained
 class Label : public View
 {
+    BRLS_POOLED_CLASS(Label)
+
   public:
     Label();
     ~Label();
@@ -56,6 +58,7 @@ class Label : public View
     void onLayout() override;
     void onFocusGained() override;
     void onFocusLost() override;
+    void onThemeChanged() override;
     void onParentFocusGained(View* focusedView) override;
     void onParentFocusLost(View* focusedView) override;
 
@@ -95,6 +98,7 @@ class Label : public View
     std::string getFullText();
 
     static View* create();
+    static const XMLAttributeTable* getXMLAttributeTable();
 
     void setRequiredWidth(float requiredWidth);
     void setEllipsisWidth(float ellipsisWidth);
@@ -139,6 +143,7 @@ class Label : public View
     float lineHeight;
 
     NVGcolor textColor;
+    bool textColorSet = false; // default color otherwise, follows the theme
 
     float requiredWidth;
     unsigned ellipsisWidth;
@@ -31,6 +31,8 @@ enum ProgressSpinnerSize
 // A progress spinner
 class ProgressSpinner : public View
 {
+    BRLS_POOLED_CLASS(ProgressSpinner)
+
   public:
     ProgressSpinner(ProgressSpinnerSize size = ProgressSpinnerSize::NORMAL);
 
@@ -41,6 +43,7 @@ class ProgressSpinner : public View
     void animate(bool animate);
 
     static brls::View* create();
+    static const XMLAttributeTable* getXMLAttributeTable();
 
   private:
     Animatable animationValue = 0.0f;
@@ -26,6 +26,8 @@ namespace brls
 // A solid color rectangle
 class Rectangle : public View
 {
+    BRLS_POOLED_CLASS(Rectangle)
+
   public:
     Rectangle(NVGcolor color);
     Rectangle();
@@ -36,6 +38,7 @@ class Rectangle : public View
     void setColor(NVGcolor color);
 
     static View* create();
+    static const XMLAttributeTable* getXMLAttributeTable();
 
   private:
     NVGcolor color = nvgRGB(0, 0, 255);
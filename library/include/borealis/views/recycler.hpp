@@ -60,9 +60,10 @@ struct IndexPath
 
 class RecyclerCell : public Box
 {
+    BRLS_POOLED_CLASS(RecyclerCell)
+
   public:
     RecyclerCell();
-    ~RecyclerCell();
 
     /*
      * Cell's position inside recycler frame
@@ -88,10 +89,13 @@ class RecyclerCell : public Box
 
     void onFocusGained() override;
     void onFocusLost() override;
+    void onThemeChanged() override;
 
   private:
     IndexPath indexPath;
-    Event<InputType>::Subscription subscription;
+    ScopedSubscription subscription;
+
+    void applyLineColor();
 };
 
 class RecyclerHeader
@@ -158,6 +162,8 @@ class RecyclerDataSource
 
 class RecyclerContentBox : public Box
 {
+    BRLS_POOLED_CLASS(RecyclerContentBox)
+
   public:
     RecyclerContentBox(RecyclerFrame* recycler);
     View* getNextFocus(FocusDirection direction, View* currentView) override;
@@ -169,6 +175,8 @@ class RecyclerContentBox : public Box
 // Custom Box for propper recycling navigation
 class RecyclerFrame : public ScrollingFrame
 {
+    BRLS_POOLED_CLASS(RecyclerFrame)
+
   public:
     RecyclerFrame();
     ~RecyclerFrame();
@@ -230,6 +238,7 @@ class RecyclerFrame : public ScrollingFrame
     }
 
     static View* create();
+    static const XMLAttributeTable* getXMLAttributeTable();
 
   private:
     RecyclerDataSource* dataSource = nullptr;
@@ -46,12 +46,14 @@ enum class ScrollingBehavior
 // so that its height can grow as much as possible.
 class ScrollingFrame : public Box
 {
+    BRLS_POOLED_CLASS(ScrollingFrame)
+
   public:
     ScrollingFrame();
-    ~ScrollingFrame();
 
     void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) override;
     void onFocusGained() override;
+    void onThemeChanged() override;
     void onChildFocusGained(View* directChild, View* focusedView) override;
     void onChildFocusLost(View* directChild, View* focusedView) override;
     void willAppear(bool resetState) override;
@@ -105,6 +107,7 @@ class ScrollingFrame : public Box
     }
 
     static View* create();
+    static const XMLAttributeTable* getXMLAttributeTable();
 
   private:
     View* contentView             = nullptr;
@@ -123,6 +126,8 @@ class ScrollingFrame : public Box
     Animatable contentOffsetY = 0.0f;
     Animatable contentOffsetX = 0.0f;
 
+    float panStartOffsetY = 0; // content offset when the current pan started
+
     void prebakeScrolling();
     bool updateScrolling(bool animated);
     void startScrolling(bool animated, float newScroll);
@@ -149,7 +154,7 @@ class ScrollingFrame : public Box
     void setupScrollingIndicator();
     void updateScrollingIndicatior();
 
-    Event<InputType>::Subscription inputTypeSubscription;
+    ScopedSubscription inputTypeSubscription;
 };
 
 } // namespace brls
@@ -30,6 +30,8 @@ class SidebarItem;
 
 class SidebarSeparator : public View
 {
+    BRLS_POOLED_CLASS(SidebarSeparator)
+
   public:
     SidebarSeparator();
 
@@ -49,11 +51,14 @@ class SidebarItemGroup
 
 class SidebarItem : public Box
 {
+    BRLS_POOLED_CLASS(SidebarItem)
+
   public:
     SidebarItem();
 
     void onFocusGained() override;
     void onFocusLost() override;
+    void onThemeChanged() override;
 
     void setGroup(SidebarItemGroup* group);
 
@@ -63,6 +68,8 @@ class SidebarItem : public Box
 
     GenericEvent* getActiveEvent();
 
+    static const XMLAttributeTable* getXMLAttributeTable();
+
   private:
     BRLS_BIND(Rectangle, accent, "brls/sidebar/item_accent");
     BRLS_BIND(Label, label, "brls/sidebar/item_label");
@@ -72,10 +79,14 @@ class SidebarItem : public Box
     SidebarItemGroup* group;
 
     bool active = false;
+
+    void applyLabelColor();
 };
 
 class Sidebar : public ScrollingFrame
 {
+    BRLS_POOLED_CLASS(Sidebar)
+
   public:
     Sidebar();
 
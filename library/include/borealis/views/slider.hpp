@@ -28,12 +28,15 @@ namespace brls
 
 class Slider : public Box
 {
+    BRLS_POOLED_CLASS(Slider)
+
   public:
     Slider();
 
     void onLayout() override;
     View* getDefaultFocus() override;
     void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) override;
+    void onThemeChanged() override;
 
     void setProgress(float progress);
 
@@ -61,6 +64,7 @@ class Slider : public Box
 
     void buttonsProcessing();
     void updateUI();
+    void applyColors();
 };
 
 } // namespace brls
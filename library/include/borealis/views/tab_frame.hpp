@@ -31,6 +31,8 @@ typedef std::function<View*(void)> TabViewCreator;
 // Only one tab is kept in memory at all times : when switching, the current tab is freed before the the new one is instantiated.
 class TabFrame : public Box
 {
+    BRLS_POOLED_CLASS(TabFrame)
+
   public:
     TabFrame();
 
@@ -18,6 +18,8 @@
 
 #include <borealis/core/application.hpp>
 #include <borealis/core/box.hpp>
+#include <borealis/core/event.hpp>
+#include <borealis/core/platform_status.hpp>
 #include <borealis/views/image.hpp>
 #include <borealis/views/rectangle.hpp>
 
@@ -26,19 +28,24 @@ namespace brls
 
 class BatteryWidget : public Box
 {
+    BRLS_POOLED_CLASS(BatteryWidget)
+
   public:
     BatteryWidget();
 
-    void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) override;
+    void onThemeChanged() override;
     static View* create();
 
   private:
     Image* back;
     Rectangle* level;
-    Platform* platform;
+
+    BatteryStatus status;
+    ScopedSubscription statusSubscription;
 
     void applyBackTheme(ThemeVariant theme);
     void applyLevelTheme(ThemeVariant theme);
+    void applyStatus(BatteryStatus status);
 };
 
 } // namespace brls
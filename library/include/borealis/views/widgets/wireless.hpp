@@ -18,6 +18,8 @@
 
 #include <borealis/core/application.hpp>
 #include <borealis/core/box.hpp>
+#include <borealis/core/event.hpp>
+#include <borealis/core/platform_status.hpp>
 #include <borealis/views/image.hpp>
 #include <borealis/views/rectangle.hpp>
 
@@ -26,10 +28,12 @@ namespace brls
 
 class WirelessWidget : public Box
 {
+    BRLS_POOLED_CLASS(WirelessWidget)
+
   public:
     WirelessWidget();
 
-    void draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx) override;
+    void onThemeChanged() override;
     static View* create();
 
   private:
@@ -37,9 +41,11 @@ class WirelessWidget : public Box
     Image* _1;
     Image* _2;
     Image* _3;
-    Platform* platform;
+
+    ScopedSubscription statusSubscription;
 
     void applyTheme(ThemeVariant theme);
+    void applyStatus(WirelessStatus status);
 };
 
 } // namespace brls
@@ -71,6 +71,12 @@ void Activity::onWindowSizeChanged()
     this->resizeToFitWindow();
 }
 
+void Activity::onThemeChanged()
+{
+    if (this->contentView)
+        this->contentView->onThemeChanged();
+}
+
 bool Activity::isTranslucent()
 {
     if (!this->contentView)
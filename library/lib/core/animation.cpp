@@ -14,54 +14,487 @@
     limitations under the License.
 */
 
+#include <algorithm>
 #include <borealis/core/animation.hpp>
+#include <borealis/core/profiler.hpp>
 #include <vector>
 
 namespace brls
 {
 
+// Amount of easing functions, running animations are grouped by easing function
+static constexpr size_t EASINGS_COUNT = (size_t)EasingFunction::backInOut + 1;
+
+// Running animations, stored as a structure of arrays per easing function
+//
+// Every running animation is advanced, eased and written back to its animatable
+// by the same few loops every frame. Each group only holds animations sharing
+// the same easing function, so that the easing loop runs a single function over
+// the whole group without branching per animation. Only step changes and callbacks
+// are handled animation by animation.
+class AnimationEngine : public Ticking
+{
+  public:
+    static AnimationEngine* getInstance()
+    {
+        // Never destroyed, animatables can outlive static destructors
+        static AnimationEngine* instance = new AnimationEngine();
+        return instance;
+    }
+
+    void add(Animatable* animatable)
+    {
+        this->load(animatable, animatable->stepElapsed);
+        this->animationsCount++;
+
+        Ticking::start();
+    }
+
+    void remove(Animatable* animatable)
+    {
+        animatable->stepElapsed = this->getElapsed(animatable);
+
+        this->detach(animatable);
+        this->animationsCount--;
+    }
+
+    // Loads the current step of the animatable, moving it to the group of its easing function
+    void load(Animatable* animatable, float stepElapsed)
+    {
+        float from            = animatable->getStepStart();
+        float to              = animatable->currentValue;
+        float duration        = 1.0f;
+        float elapsed         = 1.0f; // nothing to animate, finish right away
+        EasingFunction easing = EasingFunction::linear;
+
+        if (animatable->currentStep < animatable->steps.size())
+        {
+            const Animatable::Step& step = animatable->steps[animatable->currentStep];
+
+            to     = step.target;
+            easing = step.easing;
+
+            if (step.duration > 0)
+            {
+                duration = (float)step.duration;
+                elapsed  = stepElapsed;
+            }
+        }
+
+        size_t group = getGroup(easing);
+
+        if (animatable->slot == Animatable::NO_SLOT || animatable->group != group)
+        {
+            if (animatable->slot != Animatable::NO_SLOT)
+                this->detach(animatable);
+
+            animatable->group = group;
+            animatable->slot  = this->groups[group].push(animatable);
+        }
+
+        Group& target = this->groups[group];
+        size_t slot   = animatable->slot;
+
+        target.from[slot]     = from;
+        target.to[slot]       = to;
+        target.duration[slot] = duration;
+        target.elapsed[slot]  = elapsed;
+
+        animatable->lastStepDone = false;
+    }
+
+    float getElapsed(Animatable* animatable)
+    {
+        return this->groups[animatable->group].elapsed[animatable->slot];
+    }
+
+  protected:
+    bool onUpdate(Time delta) override
+    {
+        static ProfilerMetric* runningMetric = Profiler::getMetric("animations/running");
+        runningMetric->record(this->animationsCount);
+
+        float dt = (float)delta;
+
+        for (size_t g = 0; g < EASINGS_COUNT; g++)
+        {
+            Group& group = this->groups[g];
+            size_t count = group.owners.size();
+
+            if (count == 0)
+                continue;
+
+            float* elapsed        = group.elapsed.data();
+            float* progress       = group.progress.data();
+            float* values         = group.values.data();
+            const float* from     = group.from.data();
+            const float* to       = group.to.data();
+            const float* duration = group.duration.data();
+
+            for (size_t i = 0; i < count; i++)
+            {
+                elapsed[i] += dt;
+                progress[i] = std::min(elapsed[i] / duration[i], 1.0f);
+            }
+
+            ease((EasingFunction)g, progress, values, count);
+
+            for (size_t i = 0; i < count; i++)
+                values[i] = from[i] + (to[i] - from[i]) * values[i];
+
+            for (size_t i = 0; i < count; i++)
+                group.owners[i]->currentValue = values[i];
+        }
+
+        // Move the finished animations to their next step, if any, which can move them to another group
+        this->stepping.clear();
+        for (Group& group : this->groups)
+        {
+            for (size_t i = 0; i < group.owners.size(); i++)
+            {
+                if (group.progress[i] >= 1.0f)
+                    this->stepping.push_back(group.owners[i]);
+            }
+        }
+
+        for (Animatable* animatable : this->stepping)
+            animatable->lastStepDone = !this->nextStep(animatable);
+
+        // Callbacks can start, stop or destroy any animatable
+        this->dispatching = true;
+
+        for (Group& group : this->groups)
+            group.dispatchCount = group.owners.size();
+
+        for (Group& group : this->groups)
+        {
+            for (size_t i = 0; i < group.dispatchCount; i++)
+            {
+                Animatable* animatable = group.owners[i];
+                if (!animatable)
+                    continue;
+
+                if (animatable->tickCallback)
+                    animatable->tickCallback();
+
+                if (group.owners[i] == animatable && animatable->lastStepDone)
+                    animatable->stop(true);
+            }
+        }
+
+        this->dispatching = false;
+
+        if (this->removedCount > 0)
+        {
+            for (Group& group : this->groups)
+                group.compact();
+
+            this->removedCount = 0;
+        }
+
+        return this->animationsCount > 0;
+    }
+
+  private:
+    struct Group
+    {
+        std::vector<Animatable*> owners;
+        std::vector<float> from;
+        std::vector<float> to;
+        std::vector<float> elapsed;
+        std::vector<float> duration;
+        std::vector<float> progress;
+        std::vector<float> values;
+
+        size_t dispatchCount = 0; // animations running when the callbacks started
+
+        // Returns the slot of the new animation
+        size_t push(Animatable* animatable)
+        {
+            this->owners.push_back(animatable);
+            this->from.push_back(0.0f);
+            this->to.push_back(0.0f);
+            this->elapsed.push_back(0.0f);
+            this->duration.push_back(1.0f);
+            this->progress.push_back(0.0f);
+            this->values.push_back(0.0f);
+
+            return this->owners.size() - 1;
+        }
+
+        void swapRemove(size_t slot)
+        {
+            size_t last = this->owners.size() - 1;
+
+            if (slot != last)
+            {
+                this->owners[slot]   = this->owners[last];
+                this->from[slot]     = this->from[last];
+                this->to[slot]       = this->to[last];
+                this->elapsed[slot]  = this->elapsed[last];
+                this->duration[slot] = this->duration[last];
+                this->progress[slot] = this->progress[last];
+
+                if (this->owners[slot])
+                    this->owners[slot]->slot = slot;
+            }
+
+            this->owners.pop_back();
+            this->from.pop_back();
+            this->to.pop_back();
+            this->elapsed.pop_back();
+            this->duration.pop_back();
+            this->progress.pop_back();
+            this->values.pop_back();
+        }
+
+        void compact()
+        {
+            size_t i = 0;
+            while (i < this->owners.size())
+            {
+                if (this->owners[i])
+                    i++;
+                else
+                    this->swapRemove(i);
+            }
+        }
+    };
+
+    Group groups[EASINGS_COUNT];
+    size_t animationsCount = 0;
+
+    std::vector<Animatable*> stepping; // animations that reached the end of their step this frame
+
+    bool dispatching    = false;
+    size_t removedCount = 0;
+
+    // Default and linear easings are the same function
+    static size_t getGroup(EasingFunction easing)
+    {
+        return easing == EasingFunction::def ? (size_t)EasingFunction::linear : (size_t)easing;
+    }
+
+    // Removes the animatable from its group, keeping the indexes
+    // stable while callbacks are being executed
+    void detach(Animatable* animatable)
+    {
+        Group& group = this->groups[animatable->group];
+        size_t slot  = animatable->slot;
+
+        animatable->slot = Animatable::NO_SLOT;
+
+        if (this->dispatching)
+        {
+            group.owners[slot] = nullptr;
+            this->removedCount++;
+        }
+        else
+        {
+            group.swapRemove(slot);
+        }
+    }
+
+#define EASE_GROUP(name)                                                    \
+    case EasingFunction::name:                                              \
+        for (size_t i = 0; i < count; i++)                                  \
+            values[i] = tweeny::easing::name.run(positions[i], 0.0f, 1.0f); \
+        return;
+
+    // Eases the given positions with a single easing function,
+    // the function is only picked once for all of them
+    static void ease(EasingFunction easing, const float* positions, float* values, size_t count)
+    {
+        switch (easing)
+        {
+            case EasingFunction::def:
+            case EasingFunction::linear:
+                break;
+            EASE_GROUP(stepped)
+            EASE_GROUP(quadraticIn)
+            EASE_GROUP(quadraticOut)
+            EASE_GROUP(quadraticInOut)
+            EASE_GROUP(cubicIn)
+            EASE_GROUP(cubicOut)
+            EASE_GROUP(cubicInOut)
+            EASE_GROUP(quarticIn)
+            EASE_GROUP(quarticOut)
+            EASE_GROUP(quarticInOut)
+            EASE_GROUP(quinticIn)
+            EASE_GROUP(quinticOut)
+            EASE_GROUP(quinticInOut)
+            EASE_GROUP(sinusoidalIn)
+            EASE_GROUP(sinusoidalOut)
+            EASE_GROUP(sinusoidalInOut)
+            EASE_GROUP(exponentialIn)
+            EASE_GROUP(exponentialOut)
+            EASE_GROUP(exponentialInOut)
+            EASE_GROUP(circularIn)
+            EASE_GROUP(circularOut)
+            EASE_GROUP(circularInOut)
+            EASE_GROUP(bounceIn)
+            EASE_GROUP(bounceOut)
+            EASE_GROUP(bounceInOut)
+            EASE_GROUP(elasticIn)
+            EASE_GROUP(elasticOut)
+            EASE_GROUP(elasticInOut)
+            EASE_GROUP(backIn)
+            EASE_GROUP(backOut)
+            EASE_GROUP(backInOut)
+        }
+
+        std::copy(positions, positions + count, values);
+    }
+
+#undef EASE_GROUP
+
+    static float ease(EasingFunction easing, float position)
+    {
+        float value;
+        ease(easing, &position, &value, 1);
+        return value;
+    }
+
+    // Moves the animation to its next step, keeping the time that
+    // overflowed the finished one. Returns false if there is no step left.
+    bool nextStep(Animatable* animatable)
+    {
+        while (animatable->currentStep + 1 < animatable->steps.size())
+        {
+            Group* group   = &this->groups[animatable->group];
+            float overflow = group->elapsed[animatable->slot] - group->duration[animatable->slot];
+
+            animatable->currentStep++;
+            this->load(animatable, overflow);
+
+            group       = &this->groups[animatable->group];
+            size_t slot = animatable->slot;
+
+            if (group->elapsed[slot] < group->duration[slot])
+            {
+                float position           = group->elapsed[slot] / group->duration[slot];
+                animatable->currentValue = group->from[slot] + (group->to[slot] - group->from[slot]) * ease((EasingFunction)animatable->group, position);
+                return true;
+            }
+
+            animatable->currentValue = group->to[slot];
+        }
+
+        return false;
+    }
+};
+
 Animatable::Animatable(float value)
     : currentValue(value)
+    , initialValue(value)
 {
 }
 
-void Animatable::onReset()
+Animatable::~Animatable()
 {
-    this->tween = tweeny::tween<float>::from(this->currentValue);
+    this->stop();
+}
+
+void Animatable::start()
+{
+    if (this->isRunning())
+        return;
+
+    AnimationEngine::getInstance()->add(this);
+}
+
+void Animatable::stop()
+{
+    this->stop(false);
+}
+
+void Animatable::stop(bool finished)
+{
+    if (!this->isRunning())
+        return;
+
+    AnimationEngine::getInstance()->remove(this);
+
+    if (this->endCallback)
+        this->endCallback(finished);
 }
 
 void Animatable::reset(float initialValue)
 {
     this->currentValue = initialValue;
-    FiniteTicking::reset();
+    this->reset();
 }
 
 void Animatable::reset()
 {
-    FiniteTicking::reset();
+    this->stop();
+
+    this->steps.clear();
+    this->currentStep  = 0;
+    this->stepElapsed  = 0.0f;
+    this->initialValue = this->currentValue;
 }
 
-void Animatable::onRewind()
+void Animatable::rewind()
 {
-    this->currentValue = this->tween.seek(0);
+    this->currentStep  = 0;
+    this->stepElapsed  = 0.0f;
+    this->currentValue = this->initialValue;
+
+    if (this->isRunning())
+        AnimationEngine::getInstance()->load(this, 0.0f);
 }
 
 void Animatable::addStep(float targetValue, int32_t duration, EasingFunction easing)
 {
-    this->tween.to(targetValue).during(duration).via(easing);
+    this->steps.push_back({ targetValue, duration, easing });
 }
 
 float Animatable::getProgress()
 {
-    return this->tween.progress();
+    float total = 0.0f;
+    float done  = 0.0f;
+
+    float elapsed = this->isRunning() ? AnimationEngine::getInstance()->getElapsed(this) : this->stepElapsed;
+
+    for (size_t i = 0; i < this->steps.size(); i++)
+    {
+        float duration = (float)std::max(this->steps[i].duration, 0);
+        total += duration;
+
+        if (i < this->currentStep)
+            done += duration;
+        else if (i == this->currentStep)
+            done += std::min(elapsed, duration);
+    }
+
+    if (total <= 0.0f)
+        return this->steps.empty() ? 0.0f : 1.0f;
+
+    return std::min(done / total, 1.0f);
+}
+
+void Animatable::setEndCallback(TickingEndCallback endCallback)
+{
+    this->endCallback = endCallback;
 }
 
-bool Animatable::onUpdate(retro_time_t delta)
+void Animatable::setTickCallback(TickingTickCallback tickCallback)
 {
-    // int32_t for stepping works as long as the app goes faster than 0.00001396983 FPS
-    // (in which case the delta for a frame wraps in an int32_t)
-    this->currentValue = this->tween.step((int32_t)delta);
-    return this->tween.progress() < 1.0f;
+    this->tickCallback = tickCallback;
+}
+
+bool Animatable::isRunning()
+{
+    return this->slot != NO_SLOT;
+}
+
+float Animatable::getStepStart()
+{
+    if (this->currentStep == 0 || this->steps.empty())
+        return this->initialValue;
+
+    return this->steps[std::min(this->currentStep, this->steps.size()) - 1].target;
 }
 
 float Animatable::getValue()
@@ -97,7 +530,7 @@ static double highlightColor     = 0;
 
 void updateHighlightAnimation()
 {
-    Time currentTime = getCPUTimeUsec() / 1000;
+    Time currentTime = getTimeUsec() / 1000;
 
     // Update variables
     highlightGradientX = (cos((double)currentTime / HIGHLIGHT_SPEED / 3.0) + 1.0) / 2.0;
@@ -25,9 +25,12 @@
 #include <borealis/core/application.hpp>
 #include <borealis/core/font.hpp>
 #include <borealis/core/i18n.hpp>
+#include <borealis/core/platform_status.hpp>
+#include <borealis/core/startup.hpp>
 #include <borealis/core/thread.hpp>
 #include <borealis/core/time.hpp>
 #include <borealis/core/util.hpp>
+#include <borealis/views/async_layout.hpp>
 #include <borealis/views/bottom_bar.hpp>
 #include <borealis/views/button.hpp>
 #include <borealis/views/cells/cell_bool.hpp>
@@ -69,6 +72,9 @@ namespace brls
 
 bool Application::init()
 {
+    Logger::start();
+    Startup::begin();
+
     // Init platform
     Application::platform = Platform::createPlatform();
 
@@ -80,11 +86,34 @@ bool Application::init()
 
     Logger::info("Using platform {}", platform->getName());
 
-    // Init i18n
-    loadTranslations();
+    // Resolve the theme once, the platform is not asked again
+    Application::themeVariant = platform->getThemeVariant();
+    Application::theme        = Application::themeVariant == ThemeVariant::LIGHT ? getLightTheme() : getDarkTheme();
 
     Threading::start();
 
+    // Start loading the assets, in parallel with the window creation
+    // Only what the first frame needs is waited for in createWindow()
+    Application::windowMilestone = Startup::addMilestone("window");
+
+    loadTranslationsAsync();
+
+    Application::platform->getFontLoader()->loadFonts();
+
+    // Load most commonly used sounds once the first frame is drawn,
+    // they are loaded on demand if played before
+    Startup::add(
+        "sounds", StartupThread::MAIN, [] {
+            AudioPlayer* audioPlayer = Application::getAudioPlayer();
+            for (enum Sound sound : {
+                     SOUND_FOCUS_CHANGE,
+                     SOUND_FOCUS_ERROR,
+                     SOUND_CLICK,
+                 })
+                audioPlayer->load(sound);
+        },
+        {}, false);
+
     Application::inited = true;
 
     return true;
@@ -101,17 +130,10 @@ void Application::createWindow(std::string windowTitle)
     // Create the actual window
     Application::getPlatform()->createWindow(windowTitle, ORIGINAL_WINDOW_WIDTH, ORIGINAL_WINDOW_HEIGHT);
 
-    // Load most commonly used sounds
-    AudioPlayer* audioPlayer = Application::getAudioPlayer();
-    for (enum Sound sound : {
-             SOUND_FOCUS_CHANGE,
-             SOUND_FOCUS_ERROR,
-             SOUND_CLICK,
-         })
-        audioPlayer->load(sound);
+    Startup::reach(Application::windowMilestone);
 
-    // Init rng
-    std::srand(std::time(nullptr));
+    // Init rng, from the library clock so that a manual clock gives reproducible runs
+    std::srand((unsigned)getTimeUsec());
 
     // Init static variables
     Application::currentFocus = nullptr;
@@ -131,35 +153,16 @@ void Application::createWindow(std::string windowTitle)
             view->onLayout();
     });
 
-    // Load fonts and setup fallbacks
-    Application::platform->getFontLoader()->loadFonts();
-
-    int regular = Application::getFont(FONT_REGULAR);
-    if (regular != FONT_INVALID)
-    {
-        NVGcontext* vg = Application::getNVGContext();
+    // Register built-in XML views
+    Startup::add("xml/views", StartupThread::MAIN, Application::registerBuiltInXMLViews);
 
-        // Switch icons
-        int switchIcons = Application::getFont(FONT_SWITCH_ICONS);
-        if (switchIcons != FONT_INVALID)
-            nvgAddFallbackFontId(vg, regular, switchIcons);
-        else
-            Logger::warning("Switch icons font was not loaded, icons will not be displayed");
+    // Wait for the translations, fonts... needed to draw the first frame
+    Startup::waitForBlockingTasks();
 
-        // Material icons
-        int materialIcons = Application::getFont(FONT_MATERIAL_ICONS);
-        if (materialIcons != FONT_INVALID)
-            nvgAddFallbackFontId(vg, regular, materialIcons);
-        else
-            Logger::warning("Material icons font was not loaded, icons will not be displayed");
-    }
-    else
-    {
+    if (Application::getFont(FONT_REGULAR) == FONT_INVALID)
         Logger::warning("Regular font was not loaded, there will be no text displayed in the app");
-    }
-
-    // Register built-in XML views
-    Application::registerBuiltInXMLViews();
+    else if (Application::getFont(FONT_SWITCH_ICONS) == FONT_INVALID)
+        Logger::warning("Switch icons font was not loaded, icons will not be displayed");
 }
 
 bool Application::mainLoop()
@@ -187,6 +190,17 @@ bool Application::mainLoop()
     inputManager->updateMouseStates(&rawMouse);
     inputManager->updateUnifiedControllerState(&controllerState);
 
+    // Stamp the samples the platform driver did not timestamp itself
+    Time inputTime = getTimeUsec();
+    for (RawTouchState& touch : rawTouch)
+    {
+        if (touch.timestamp == 0)
+            touch.timestamp = inputTime;
+    }
+
+    if (rawMouse.timestamp == 0)
+        rawMouse.timestamp = inputTime;
+
     if (isSwapInputKeys())
     {
         bool swapKeys[ControllerButton::_BUTTON_MAX];
@@ -327,9 +341,9 @@ bool Application::mainLoop()
             buttonPressTime = repeatingButtonTimer = 0;
     }
 
-    if (anyButtonPressed && getCPUTimeUsec() - buttonPressTime > 1000)
+    if (anyButtonPressed && getTimeUsec() - buttonPressTime > 1000)
     {
-        buttonPressTime = getCPUTimeUsec();
+        buttonPressTime = getTimeUsec();
         repeatingButtonTimer++; // Increased once every ~1ms
     }
 
@@ -342,6 +356,13 @@ bool Application::mainLoop()
     // Render
     Application::frame();
 
+    static bool firstFrame = true;
+    if (firstFrame)
+    {
+        firstFrame = false;
+        Startup::onFirstFrame();
+    }
+
     // Trigger RunLoop subscribers
     runLoopEvent.fire();
 
@@ -440,7 +461,7 @@ void Application::onControllerButtonPressed(enum ControllerButton button, bool r
 {
     if (Application::blockInputsTokens != 0)
     {
-        Logger::debug("{} button press blocked (tokens={})", button, Application::blockInputsTokens);
+        BRLS_LOG_DEBUG("{} button press blocked (tokens={})", button, Application::blockInputsTokens);
         if (!muteSounds)
             Application::getAudioPlayer()->play(Sound::SOUND_CLICK_ERROR);
         return;
@@ -627,8 +648,11 @@ void Application::exit()
 
     Application::deletionPool.clear();
 
+    PlatformStatus::stop();
     Threading::stop();
     delete Application::platform;
+
+    Logger::stop();
 }
 
 void Application::setDisplayFramerate(bool enabled)
@@ -692,7 +716,7 @@ void Application::giveFocus(View* view)
         if (newFocus)
         {
             newFocus->onFocusGained();
-            Logger::debug("Giving focus to {}", newFocus->describe());
+            BRLS_LOG_DEBUG("Giving focus to {}", newFocus->describe());
         }
 
         Application::globalHintsUpdateEvent.fire();
@@ -761,7 +785,7 @@ bool Application::popActivity(TransitionAnimation animation, std::function<void(
     {
         View* newFocus = Application::focusStack[Application::focusStack.size() - 1];
 
-        Logger::debug("Giving focus to {}, and removing it from the focus stack", newFocus->describe());
+        BRLS_LOG_DEBUG("Giving focus to {}, and removing it from the focus stack", newFocus->describe());
 
         Application::giveFocus(newFocus);
         Application::focusStack.pop_back();
@@ -780,7 +804,14 @@ void Application::pushActivity(Activity* activity, TransitionAnimation animation
 
     // Create the activity content view
     activity->setContentView(activity->createContentView());
-    activity->onContentAvailable();
+
+    // Content inflated in the background is only available once inflated
+    AsyncLayout* asyncContent = dynamic_cast<AsyncLayout*>(activity->getContentView());
+
+    if (asyncContent && !asyncContent->isInflated())
+        asyncContent->getInflatedEvent()->subscribe([activity](View* view) { activity->onContentAvailable(); });
+    else
+        activity->onContentAvailable();
 
     // Call hide() on the previous activity in the stack if no
     // activities are translucent, then call show() once the animation ends
@@ -831,7 +862,7 @@ void Application::pushActivity(Activity* activity, TransitionAnimation animation
     // Focus
     if (Application::activitiesStack.size() > 0 && Application::currentFocus != nullptr)
     {
-        Logger::debug("Pushing {} to the focus stack", Application::currentFocus->describe());
+        BRLS_LOG_DEBUG("Pushing {} to the focus stack", Application::currentFocus->describe());
         Application::focusStack.push_back(Application::currentFocus);
     }
 
@@ -854,17 +885,30 @@ void Application::clear()
     Application::activitiesStack.clear();
 }
 
-Theme Application::getTheme()
+const Theme& Application::getTheme()
 {
-    if (Application::getThemeVariant() == ThemeVariant::LIGHT)
-        return getLightTheme();
-    else
-        return getDarkTheme();
+    return Application::theme;
 }
 
 ThemeVariant Application::getThemeVariant()
 {
-    return Application::platform->getThemeVariant();
+    return Application::themeVariant;
+}
+
+void Application::setThemeVariant(ThemeVariant variant)
+{
+    if (variant == Application::themeVariant)
+        return;
+
+    Logger::info("Switching to the {} theme", variant == ThemeVariant::LIGHT ? "light" : "dark");
+
+    Application::themeVariant = variant;
+    Application::theme        = variant == ThemeVariant::LIGHT ? getLightTheme() : getDarkTheme();
+
+    for (Activity* activity : Application::activitiesStack)
+        activity->onThemeChanged();
+
+    Application::themeChangeEvent.fire(variant);
 }
 
 std::string Application::getLocale()
@@ -901,6 +945,17 @@ void Application::tryDeinitFirstResponder(View* view)
 
 bool Application::loadFontFromFile(std::string fontName, std::string filePath)
 {
+    // Font loaders run before the window is created, register the font once it is
+    if (!Application::isWindowCreated())
+    {
+        Startup::add(
+            "fonts/" + fontName + "/register", StartupThread::MAIN, [fontName, filePath] {
+                Application::loadFontFromFile(fontName, filePath);
+            },
+            { Application::windowMilestone });
+        return true;
+    }
+
     int handle = nvgCreateFont(Application::getNVGContext(), fontName.c_str(), filePath.c_str());
 
     if (handle == FONT_INVALID)
@@ -910,11 +965,22 @@ bool Application::loadFontFromFile(std::string fontName, std::string filePath)
     }
 
     Application::fontStash[fontName] = handle;
+    Application::updateFontFallbacks();
     return true;
 }
 
 bool Application::loadFontFromMemory(std::string fontName, void* address, size_t size, bool freeData)
 {
+    if (!Application::isWindowCreated())
+    {
+        Startup::add(
+            "fonts/" + fontName + "/register", StartupThread::MAIN, [fontName, address, size, freeData] {
+                Application::loadFontFromMemory(fontName, address, size, freeData);
+            },
+            { Application::windowMilestone });
+        return true;
+    }
+
     int handle = nvgCreateFontMem(Application::getNVGContext(), fontName.c_str(), (unsigned char*)address, size, freeData);
 
     if (handle == FONT_INVALID)
@@ -924,6 +990,7 @@ bool Application::loadFontFromMemory(std::string fontName, void* address, size_t
     }
 
     Application::fontStash[fontName] = handle;
+    Application::updateFontFallbacks();
     return true;
 }
 
@@ -937,7 +1004,7 @@ void Application::blockInputs(bool muteSounds)
     Application::muteSounds |= muteSounds;
     Application::blockInputsTokens += 1;
     getGlobalHintsUpdateEvent()->fire();
-    Logger::debug("Adding an inputs block token (tokens={})", Application::blockInputsTokens);
+    BRLS_LOG_DEBUG("Adding an inputs block token (tokens={})", Application::blockInputsTokens);
 }
 
 void Application::unblockInputs()
@@ -948,7 +1015,7 @@ void Application::unblockInputs()
         muteSounds = false;
 
     getGlobalHintsUpdateEvent()->fire();
-    Logger::debug("Removing an inputs block token (tokens={})", Application::blockInputsTokens);
+    BRLS_LOG_DEBUG("Removing an inputs block token (tokens={})", Application::blockInputsTokens);
 }
 
 bool Application::isInputBlocks()
@@ -994,7 +1061,7 @@ void Application::onWindowResized(int width, int height)
     Logger::info("New scale factor is {}", Application::windowScale);
 
     // Trigger a layout
-    Logger::debug("Layout triggered");
+    BRLS_LOG_DEBUG("Layout triggered");
 
     for (Activity* activity : Application::activitiesStack)
         activity->onWindowSizeChanged();
@@ -1025,6 +1092,11 @@ VoidEvent* Application::getRunLoopEvent()
     return &Application::runLoopEvent;
 }
 
+Event<ThemeVariant>* Application::getThemeChangeEvent()
+{
+    return &Application::themeChangeEvent;
+}
+
 int Application::getFont(std::string fontName)
 {
     if (Application::fontStash.count(fontName) == 0)
@@ -1033,16 +1105,53 @@ int Application::getFont(std::string fontName)
     return Application::fontStash[fontName];
 }
 
+StartupTaskId Application::getWindowMilestone()
+{
+    return Application::windowMilestone;
+}
+
+bool Application::isWindowCreated()
+{
+    if (!Application::platform)
+        fatal("Please call brls::Application::init() before loading fonts.");
+
+    return Startup::isDone(Application::windowMilestone);
+}
+
+void Application::updateFontFallbacks()
+{
+    int regular = Application::getFont(FONT_REGULAR);
+    if (regular == FONT_INVALID)
+        return;
+
+    for (const std::string& fallback : { FONT_SWITCH_ICONS, FONT_MATERIAL_ICONS })
+    {
+        int font = Application::getFont(fallback);
+        if (font != FONT_INVALID && Application::fontFallbacks.insert(fallback).second)
+            nvgAddFallbackFontId(Application::getNVGContext(), regular, font);
+    }
+}
+
 bool Application::XMLViewsRegisterContains(std::string name)
 {
+    std::lock_guard<std::mutex> guard(Application::xmlViewsRegisterMutex);
     return Application::xmlViewsRegister.count(name) > 0;
 }
 
 XMLViewCreator Application::getXMLViewCreator(std::string name)
 {
+    std::lock_guard<std::mutex> guard(Application::xmlViewsRegisterMutex);
     return Application::xmlViewsRegister[name];
 }
 
+const XMLViewCreator* Application::findXMLViewCreator(const std::string& name)
+{
+    // Elements are never removed, and rehashing doesn't move them: the pointer stays valid once unlocked
+    std::lock_guard<std::mutex> guard(Application::xmlViewsRegisterMutex);
+    auto it = Application::xmlViewsRegister.find(name);
+    return it != Application::xmlViewsRegister.end() ? &it->second : nullptr;
+}
+
 void Application::registerBuiltInXMLViews()
 {
     Application::registerXMLView("brls:Box", Box::create);
@@ -1062,6 +1171,7 @@ void Application::registerBuiltInXMLViews()
     Application::registerXMLView("brls:Slider", Slider::create);
     Application::registerXMLView("brls:BottomBar", BottomBar::create);
     Application::registerXMLView("brls:ProgressSpinner", ProgressSpinner::create);
+    Application::registerXMLView("brls:AsyncLayout", AsyncLayout::create);
 
     // Cells
     Application::registerXMLView("brls:DetailCell", DetailCell::create);
@@ -1078,6 +1188,7 @@ void Application::registerBuiltInXMLViews()
 
 void Application::registerXMLView(std::string name, XMLViewCreator creator)
 {
+    std::lock_guard<std::mutex> guard(Application::xmlViewsRegisterMutex);
     Application::xmlViewsRegister[name] = creator;
 }
 
@@ -40,70 +40,74 @@ static YGFlexDirection getYGFlexDirection(Axis axis)
 Box::Box(Axis axis)
     : axis(axis)
 {
+    this->setXMLAttributeTable(Box::getXMLAttributeTable());
+
     YGNodeStyleSetFlexDirection(this->ygNode, getYGFlexDirection(axis));
 
     // no need to invalidate if the box is empty and is not attached to any parent
+}
 
-    // Register XML attributes
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "axis", Axis, this->setAxis,
-        {
-            { "row", Axis::ROW },
-            { "column", Axis::COLUMN },
-        });
+const XMLAttributeTable* Box::getXMLAttributeTable()
+{
+    static XMLAttributes<Box> attributes = [] {
+        XMLAttributes<Box> attributes(View::getXMLAttributeTable());
 
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "direction", Direction, this->setDirection,
-        {
-            { "inherit", Direction::INHERIT },
-            { "leftToRight", Direction::LEFT_TO_RIGHT },
-            { "rightToLeft", Direction::RIGHT_TO_LEFT },
-        });
+        BRLS_REGISTER_CLASS_ENUM_XML_ATTRIBUTE(
+            attributes, "axis", Axis, &Box::setAxis,
+            {
+                { "row", Axis::ROW },
+                { "column", Axis::COLUMN },
+            });
 
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "justifyContent", JustifyContent, this->setJustifyContent,
-        {
-            { "flexStart", JustifyContent::FLEX_START },
-            { "center", JustifyContent::CENTER },
-            { "flexEnd", JustifyContent::FLEX_END },
-            { "spaceBetween", JustifyContent::SPACE_BETWEEN },
-            { "spaceAround", JustifyContent::SPACE_AROUND },
-            { "spaceEvenly", JustifyContent::SPACE_EVENLY },
-        });
+        BRLS_REGISTER_CLASS_ENUM_XML_ATTRIBUTE(
+            attributes, "direction", Direction, &Box::setDirection,
+            {
+                { "inherit", Direction::INHERIT },
+                { "leftToRight", Direction::LEFT_TO_RIGHT },
+                { "rightToLeft", Direction::RIGHT_TO_LEFT },
+            });
 
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "alignItems", AlignItems, this->setAlignItems,
-        {
-            { "auto", AlignItems::AUTO },
-            { "flexStart", AlignItems::FLEX_START },
-            { "center", AlignItems::CENTER },
-            { "flexEnd", AlignItems::FLEX_END },
-            { "stretch", AlignItems::STRETCH },
-            { "baseline", AlignItems::BASELINE },
-            { "spaceBetween", AlignItems::SPACE_BETWEEN },
-            { "spaceAround", AlignItems::SPACE_AROUND },
-        });
+        BRLS_REGISTER_CLASS_ENUM_XML_ATTRIBUTE(
+            attributes, "justifyContent", JustifyContent, &Box::setJustifyContent,
+            {
+                { "flexStart", JustifyContent::FLEX_START },
+                { "center", JustifyContent::CENTER },
+                { "flexEnd", JustifyContent::FLEX_END },
+                { "spaceBetween", JustifyContent::SPACE_BETWEEN },
+                { "spaceAround", JustifyContent::SPACE_AROUND },
+                { "spaceEvenly", JustifyContent::SPACE_EVENLY },
+            });
+
+        BRLS_REGISTER_CLASS_ENUM_XML_ATTRIBUTE(
+            attributes, "alignItems", AlignItems, &Box::setAlignItems,
+            {
+                { "auto", AlignItems::AUTO },
+                { "flexStart", AlignItems::FLEX_START },
+                { "center", AlignItems::CENTER },
+                { "flexEnd", AlignItems::FLEX_END },
+                { "stretch", AlignItems::STRETCH },
+                { "baseline", AlignItems::BASELINE },
+                { "spaceBetween", AlignItems::SPACE_BETWEEN },
+                { "spaceAround", AlignItems::SPACE_AROUND },
+            });
+
+        // Padding
+        attributes.registerFloat("paddingTop", &Box::setPaddingTop);
 
-    // Padding
-    this->registerFloatXMLAttribute("paddingTop", [this](float value) {
-        this->setPaddingTop(value);
-    });
+        attributes.registerFloat("paddingRight", &Box::setPaddingRight);
 
-    this->registerFloatXMLAttribute("paddingRight", [this](float value) {
-        this->setPaddingRight(value);
-    });
+        attributes.registerFloat("paddingBottom", &Box::setPaddingBottom);
 
-    this->registerFloatXMLAttribute("paddingBottom", [this](float value) {
-        this->setPaddingBottom(value);
-    });
+        attributes.registerFloat("paddingLeft", &Box::setPaddingLeft);
 
-    this->registerFloatXMLAttribute("paddingLeft", [this](float value) {
-        this->setPaddingLeft(value);
-    });
+        attributes.registerFloat("padding", [](Box* box, float value) {
+            box->setPadding(value);
+        });
 
-    this->registerFloatXMLAttribute("padding", [this](float value) {
-        this->setPadding(value);
-    });
+        return attributes;
+    }();
+
+    return &attributes;
 }
 
 Box::Box()
@@ -215,6 +219,7 @@ void Box::removeView(View* view, bool free)
     this->children.erase(this->children.begin() + index);
 
     view->willDisappear(true);
+    view->setParent(nullptr); // takes its IDs out of our tree
     if (free)
         view->freeView();
 
@@ -235,6 +240,7 @@ void Box::clearViews(bool free)
         this->children.pop_back();
 
         view->willDisappear(true);
+        view->setParent(nullptr); // takes its IDs out of our tree
         if (free)
             view->freeView();
     }
@@ -430,28 +436,48 @@ void Box::onWindowSizeChanged()
         child->onWindowSizeChanged();
 }
 
+void Box::onThemeChanged()
+{
+    View::onThemeChanged();
+
+    for (View* child : this->children)
+        child->onThemeChanged();
+}
+
 std::vector<View*>& Box::getChildren()
 {
     return this->children;
 }
 
-void Box::inflateFromXMLString(std::string xml)
+void Box::inflateFromXMLString(std::string xml, bool cache)
 {
     // Load XML
-    tinyxml2::XMLDocument* document = new tinyxml2::XMLDocument();
-    tinyxml2::XMLError error        = document->Parse(xml.c_str());
+    tinyxml2::XMLError error;
+    std::unique_ptr<XMLTemplate> ownedTemplate;
+    XMLTemplate* xmlTemplate;
 
-    this->bindXMLDocument(document);
+    if (cache)
+    {
+        xmlTemplate = XMLTemplate::fromString(xml, &error);
+    }
+    else
+    {
+        ownedTemplate = XMLTemplate::parseString(xml, &error);
+        xmlTemplate   = ownedTemplate.get();
+    }
 
-    if (error != tinyxml2::XMLError::XML_SUCCESS)
+    if (!xmlTemplate)
         fatal("Invalid XML when inflating " + this->describe() + ": error " + std::to_string(error));
 
-    tinyxml2::XMLElement* element = document->RootElement();
+    tinyxml2::XMLElement* element = xmlTemplate->getRoot();
 
     if (!element)
         fatal("Invalid XML: no element found");
 
-    return Box::inflateFromXMLElement(element);
+    Box::inflateFromXMLElement(element);
+
+    if (ownedTemplate)
+        this->bindXMLTemplate(std::move(ownedTemplate));
 }
 
 void Box::inflateFromXMLRes(std::string name)
@@ -462,15 +488,13 @@ void Box::inflateFromXMLRes(std::string name)
 void Box::inflateFromXMLFile(std::string path)
 {
     // Load XML
-    tinyxml2::XMLDocument* document = new tinyxml2::XMLDocument();
-    tinyxml2::XMLError error        = document->LoadFile(path.c_str());
-
-    this->bindXMLDocument(document);
+    tinyxml2::XMLError error;
+    XMLTemplate* xmlTemplate = XMLTemplate::fromFile(path, &error);
 
-    if (error != tinyxml2::XMLError::XML_SUCCESS)
+    if (!xmlTemplate)
         fatal("Invalid XML when inflating " + this->describe() + ": error " + std::to_string(error));
 
-    tinyxml2::XMLElement* element = document->RootElement();
+    tinyxml2::XMLElement* element = xmlTemplate->getRoot();
 
     if (!element)
         fatal("Invalid XML: no element found");
@@ -587,31 +611,12 @@ void Box::setAlignItems(AlignItems alignment)
     this->invalidate();
 }
 
-View* Box::getView(std::string id)
+bool Box::applyXMLAttributeValue(const std::string& name, const XMLValue& value)
 {
-    if (id == this->id)
-        return this;
-
-    for (View* child : this->children)
-    {
-        View* result = child->getView(id);
-
-        if (result)
-            return result;
-    }
-
-    return nullptr;
-}
-
-bool Box::applyXMLAttribute(std::string name, std::string value)
-{
-    if (this->forwardedAttributes.count(name) > 0)
-    {
-        std::pair<std::string, View*> pair = this->forwardedAttributes[name];
-        return pair.second->applyXMLAttribute(pair.first, value);
-    }
+    if (auto it = this->forwardedAttributes.find(name); it != this->forwardedAttributes.end())
+        return it->second.second->applyParsedXMLAttribute(it->second.first, value);
 
-    return View::applyXMLAttribute(name, value);
+    return View::applyXMLAttributeValue(name, value);
 }
 
 void Box::forwardXMLAttribute(std::string attributeName, View* target)
@@ -668,6 +673,8 @@ Box::~Box()
     {
         if (!it->isPtrLocked())
             delete it;
+        else
+            it->setParent(nullptr); // survives us, takes its IDs out of our tree
     }
 }
 
@@ -0,0 +1,207 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <borealis/core/compiled_layout.hpp>
+#include <borealis/core/logger.hpp>
+
+#if !defined(__SWITCH__) && !defined(_WIN32)
+#define BRLS_MMAP_LAYOUTS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace brls
+{
+
+const compiled::Element* CompiledLayouts::findLayout(const std::string& path)
+{
+    if (!loaded)
+        load();
+
+    std::string resources = BRLS_RESOURCES;
+    if (!header || path.compare(0, resources.size(), resources) != 0)
+        return nullptr;
+
+    auto it = layouts.find(path.substr(resources.size()));
+    return it != layouts.end() ? getElement(it->second) : nullptr;
+}
+
+const compiled::Element* CompiledLayouts::getElement(uint32_t index)
+{
+    return reinterpret_cast<const compiled::Element*>(data + header->elementsOffset) + index;
+}
+
+const compiled::Attribute* CompiledLayouts::getAttribute(uint32_t index)
+{
+    return reinterpret_cast<const compiled::Attribute*>(data + header->attributesOffset) + index;
+}
+
+const compiled::String* CompiledLayouts::getString(uint32_t index)
+{
+    return reinterpret_cast<const compiled::String*>(data + header->stringsOffset) + index;
+}
+
+const char* CompiledLayouts::getStringValue(uint32_t index)
+{
+    return reinterpret_cast<const char*>(data + getString(index)->offset);
+}
+
+void CompiledLayouts::load()
+{
+    loaded = true;
+
+    if (!map(BRLS_COMPILED_LAYOUTS))
+    {
+        Logger::debug("No compiled layouts found at {}, using XML layouts", BRLS_COMPILED_LAYOUTS);
+        return;
+    }
+
+    if (!validate())
+    {
+        Logger::warning("Ignoring compiled layouts {}: invalid or built for another version of the library", BRLS_COMPILED_LAYOUTS);
+        return;
+    }
+
+    header = reinterpret_cast<const compiled::Header*>(data);
+
+    const compiled::Layout* layoutsTable = reinterpret_cast<const compiled::Layout*>(data + header->layoutsOffset);
+    for (uint32_t i = 0; i < header->layoutsCount; i++)
+        layouts[getStringValue(layoutsTable[i].path)] = layoutsTable[i].root;
+
+    Logger::debug("Loaded {} compiled layouts from {}", header->layoutsCount, BRLS_COMPILED_LAYOUTS);
+}
+
+bool CompiledLayouts::map(const char* path)
+{
+#ifdef BRLS_MMAP_LAYOUTS
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // the mapping stays valid
+
+    if (mapping == MAP_FAILED)
+        return false;
+
+    data = static_cast<const uint8_t*>(mapping);
+    size = st.st_size;
+    return true;
+#else
+    // No mmap: read the whole archive once, it stays loaded for the whole application lifetime
+    FILE* file = fopen(path, "rb");
+    if (!file)
+        return false;
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    if (length <= 0)
+    {
+        fclose(file);
+        return false;
+    }
+
+    uint8_t* buffer = new uint8_t[length];
+    if (fread(buffer, 1, length, file) != (size_t)length)
+    {
+        delete[] buffer;
+        fclose(file);
+        return false;
+    }
+
+    fclose(file);
+
+    data = buffer;
+    size = length;
+    return true;
+#endif
+}
+
+bool CompiledLayouts::validate()
+{
+    if (size < sizeof(compiled::Header))
+        return false;
+
+    const compiled::Header* candidate = reinterpret_cast<const compiled::Header*>(data);
+
+    if (memcmp(candidate->magic, compiled::MAGIC, sizeof(compiled::MAGIC)) != 0 || candidate->version != compiled::VERSION)
+        return false;
+
+    auto fits = [](uint32_t offset, uint32_t count, size_t itemSize) {
+        return offset % 8 == 0 && offset <= size && count <= (size - offset) / itemSize;
+    };
+
+    if (!fits(candidate->stringsOffset, candidate->stringsCount, sizeof(compiled::String))
+        || !fits(candidate->layoutsOffset, candidate->layoutsCount, sizeof(compiled::Layout))
+        || !fits(candidate->elementsOffset, candidate->elementsCount, sizeof(compiled::Element))
+        || !fits(candidate->attributesOffset, candidate->attributesCount, sizeof(compiled::Attribute)))
+        return false;
+
+    // Strings must be null terminated inside of the archive
+    const compiled::String* strings = reinterpret_cast<const compiled::String*>(data + candidate->stringsOffset);
+    for (uint32_t i = 0; i < candidate->stringsCount; i++)
+    {
+        if ((size_t)strings[i].offset + strings[i].length >= size || data[strings[i].offset + strings[i].length] != '\0')
+            return false;
+    }
+
+    // Every index must point inside of its table, and elements are stored in
+    // document order so that children and siblings always come after an element
+    uint32_t stringsCount  = candidate->stringsCount;
+    uint32_t elementsCount = candidate->elementsCount;
+    auto isNextElement     = [elementsCount](uint32_t index, uint32_t current) { return index == compiled::NONE || (index > current && index < elementsCount); };
+
+    const compiled::Layout* layoutsTable = reinterpret_cast<const compiled::Layout*>(data + candidate->layoutsOffset);
+    for (uint32_t i = 0; i < candidate->layoutsCount; i++)
+    {
+        if (layoutsTable[i].path >= stringsCount || layoutsTable[i].root >= elementsCount)
+            return false;
+    }
+
+    const compiled::Element* elements = reinterpret_cast<const compiled::Element*>(data + candidate->elementsOffset);
+    for (uint32_t i = 0; i < elementsCount; i++)
+    {
+        const compiled::Element& element = elements[i];
+        if (element.tag >= stringsCount || (uint64_t)element.firstAttribute + element.attributesCount > candidate->attributesCount || !isNextElement(element.firstChild, i) || !isNextElement(element.nextSibling, i))
+            return false;
+    }
+
+    const compiled::Attribute* attributes = reinterpret_cast<const compiled::Attribute*>(data + candidate->attributesOffset);
+    for (uint32_t i = 0; i < candidate->attributesCount; i++)
+    {
+        const compiled::Attribute& attribute = attributes[i];
+        if (attribute.name >= stringsCount || attribute.raw >= stringsCount || attribute.text >= stringsCount)
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace brls
@@ -14,39 +14,98 @@
     limitations under the License.
 */
 
+#include <stdio.h>
+#include <stdlib.h>
 #include <unistd.h>
 
 #include <borealis/core/application.hpp>
 #include <borealis/core/assets.hpp>
 #include <borealis/core/font.hpp>
+#include <borealis/core/startup.hpp>
+#include <memory>
 
 #define MATERIAL_ICONS_PATH BRLS_ASSET("material/MaterialIcons-Regular.ttf")
 
 namespace brls
 {
 
-bool FontLoader::loadFontFromFile(std::string fontName, std::string filePath)
+// Font file read in the background, handed over to nanovg when registered
+struct FontFile
 {
-    if (access(filePath.c_str(), F_OK) != -1)
+    unsigned char* data = nullptr; // malloc'd, freed by nanovg
+    size_t size         = 0;
+};
+
+static bool readFontFile(const std::string& filePath, FontFile* font)
+{
+    FILE* file = fopen(filePath.c_str(), "rb");
+    if (!file)
+        return false;
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    if (length <= 0)
     {
-        bool loaded = Application::loadFontFromFile(fontName, filePath);
+        fclose(file);
+        return false;
+    }
 
-        if (!loaded)
-        {
-            Logger::error("{} font was located but couldn't be loaded", fontName);
-            return false;
-        }
+    font->data = (unsigned char*)malloc(length);
+    font->size = length;
 
-        return true;
+    bool read = fread(font->data, 1, length, file) == (size_t)length;
+    fclose(file);
+
+    if (!read)
+    {
+        free(font->data);
+        font->data = nullptr;
     }
 
-    Logger::error("\"{}\" font couldn't be located (searched at \"{}\")", fontName, filePath);
-    return false;
+    return read;
+}
+
+bool FontLoader::loadFontFromFile(std::string fontName, std::string filePath, bool lazy)
+{
+    if (access(filePath.c_str(), F_OK) == -1)
+    {
+        Logger::error("\"{}\" font couldn't be located (searched at \"{}\")", fontName, filePath);
+        return false;
+    }
+
+    std::shared_ptr<FontFile> font = std::make_shared<FontFile>();
+
+    StartupTaskId read = Startup::add(
+        "fonts/" + fontName + "/read", StartupThread::WORKER, [fontName, filePath, font] {
+            if (!readFontFile(filePath, font.get()))
+                Logger::error("{} font was located but couldn't be loaded", fontName);
+        },
+        {}, !lazy);
+
+    Startup::add(
+        "fonts/" + fontName + "/register", StartupThread::MAIN, [fontName, font] {
+            if (font->data)
+                Application::loadFontFromMemory(fontName, font->data, font->size, true);
+        },
+        { read, Application::getWindowMilestone() }, !lazy);
+
+    return true;
+}
+
+void FontLoader::loadFontFromMemory(std::string fontName, void* address, size_t size, bool lazy)
+{
+    Startup::add(
+        "fonts/" + fontName + "/register", StartupThread::MAIN, [fontName, address, size] {
+            Application::loadFontFromMemory(fontName, address, size, false);
+        },
+        { Application::getWindowMilestone() }, !lazy);
 }
 
 bool FontLoader::loadMaterialFromResources()
 {
-    return this->loadFontFromFile(FONT_MATERIAL_ICONS, MATERIAL_ICONS_PATH);
+    return this->loadFontFromFile(FONT_MATERIAL_ICONS, MATERIAL_ICONS_PATH, true);
 }
 
 } // namespace brls
@@ -14,11 +14,15 @@
     limitations under the License.
 */
 
+#include <atomic>
 #include <borealis/core/application.hpp>
 #include <borealis/core/assets.hpp>
 #include <borealis/core/i18n.hpp>
+#include <borealis/core/interned_key.hpp>
+#include <borealis/core/startup.hpp>
 #include <filesystem>
 #include <fstream>
+#include <memory>
 #include <nlohmann/json.hpp>
 #include <string>
 
@@ -29,8 +33,22 @@
 namespace brls
 {
 
-static nlohmann::json defaultLocale = {};
-static nlohmann::json currentLocale = {};
+// Location of a translation in the strings arena
+struct TranslationString
+{
+    uint32_t offset = 0;
+    uint32_t length = 0;
+};
+
+// Translations of the current locale and the default locale, flattened when loaded:
+// "brls/hints/ok" -> "OK". Every translation is stored in the same arena, and names
+// missing from the current locale already point to the default locale translation.
+static KeyTable<TranslationString> translations;
+static std::string translationsArena;
+
+// Set while the translations are loaded by the startup tasks
+static std::atomic<bool> translationsPending = false;
+static StartupTaskId translationsTask;
 
 static bool endsWith(const std::string& str, const std::string& suffix)
 {
@@ -86,51 +104,115 @@ static void loadLocale(std::string locale, nlohmann::json* target)
     }
 }
 
+// Adds every string of the given locale to the translations table, named after their path
+// Strings already in the table are kept, so the current locale must be flattened first.
+static void flattenLocale(const nlohmann::json& json, const std::string& name)
+{
+    if (json.is_object())
+    {
+        for (auto& item : json.items())
+            flattenLocale(item.value(), name.empty() ? item.key() : name + "/" + item.key());
+    }
+    else if (json.is_array())
+    {
+        for (size_t i = 0; i < json.size(); i++)
+            flattenLocale(json[i], name + "/" + std::to_string(i));
+    }
+    else if (json.is_string())
+    {
+        const std::string& value = json.get_ref<const std::string&>();
+
+        TranslationString string;
+        string.offset = translationsArena.size();
+        string.length = value.size();
+
+        if (!translations.insert(name, string))
+        {
+            Logger::error("Cannot load string \"{}\": its name collides with another string", name);
+            return;
+        }
+
+        // Only keep the characters if the string was not already there
+        if (translations.find(InternedKey(name))->offset == string.offset)
+            translationsArena += value;
+    }
+}
+
+static void flattenTranslations(const nlohmann::json& currentLocale, const nlohmann::json& defaultLocale)
+{
+    // Current locale first, so that the default locale only fills in the missing strings
+    flattenLocale(currentLocale, "");
+    flattenLocale(defaultLocale, "");
+
+    translationsArena.shrink_to_fit();
+}
+
 void loadTranslations()
 {
+    nlohmann::json defaultLocale = {};
+    nlohmann::json currentLocale = {};
+
     loadLocale(LOCALE_DEFAULT, &defaultLocale);
 
     std::string currentLocaleName = Application::getLocale();
     if (currentLocaleName != LOCALE_DEFAULT)
         loadLocale(currentLocaleName, &currentLocale);
+
+    flattenTranslations(currentLocale, defaultLocale);
+}
+
+void loadTranslationsAsync()
+{
+    auto defaultLocale = std::make_shared<nlohmann::json>();
+    auto currentLocale = std::make_shared<nlohmann::json>();
+
+    // Both locales are read and parsed in parallel
+    std::vector<StartupTaskId> locales;
+    locales.push_back(Startup::add("i18n/" + LOCALE_DEFAULT, StartupThread::WORKER, [defaultLocale] { loadLocale(LOCALE_DEFAULT, defaultLocale.get()); }));
+
+    std::string currentLocaleName = Application::getLocale();
+    if (currentLocaleName != LOCALE_DEFAULT)
+        locales.push_back(Startup::add("i18n/" + currentLocaleName, StartupThread::WORKER, [currentLocale, currentLocaleName] { loadLocale(currentLocaleName, currentLocale.get()); }));
+
+    translationsPending = true;
+    translationsTask    = Startup::add(
+        "i18n/flatten", StartupThread::WORKER, [defaultLocale, currentLocale] {
+            flattenTranslations(*currentLocale, *defaultLocale);
+            translationsPending = false;
+        },
+        locales);
 }
 
 namespace internal
 {
-    std::string getRawStr(std::string stringName)
+    // Returns the translation of the string with the given key, or nullptr if there is none
+    static const TranslationString* findRawStr(InternedKey key)
     {
-        nlohmann::json::json_pointer pointer;
+        return translations.find(key);
+    }
 
-        try
-        {
-            pointer = nlohmann::json::json_pointer("/" + std::string(BRLS_I18N_PREFIX) + stringName);
-        }
-        catch (const std::exception& e)
-        {
-            Logger::error("Error while getting string \"{}\": {}", stringName, e.what());
-            return stringName;
-        }
+    static std::string getRawStr(const char* stringName, size_t length)
+    {
+        const TranslationString* string;
 
-        // First look for translated string in current locale
-        try
-        {
-            return currentLocale[pointer].get<std::string>();
-        }
-        catch (...)
-        {
-        }
+        if (translationsPending)
+            Startup::wait(translationsTask);
 
-        // Then look for default locale
-        try
-        {
-            return defaultLocale[pointer].get<std::string>();
-        }
-        catch (...)
-        {
-        }
+        if (sizeof(BRLS_I18N_PREFIX) > 1)
+            string = findRawStr(InternedKey(std::string(BRLS_I18N_PREFIX) + std::string(stringName, length)));
+        else
+            string = findRawStr(InternedKey(hashKey(stringName, length), stringName));
 
         // Fallback to returning the string name
-        return stringName;
+        if (!string)
+            return std::string(stringName, length);
+
+        return translationsArena.substr(string->offset, string->length);
+    }
+
+    std::string getRawStr(std::string stringName)
+    {
+        return getRawStr(stringName.c_str(), stringName.size());
     }
 } // namespace internal
 
@@ -138,7 +220,7 @@ inline namespace literals
 {
     std::string operator"" _i18n(const char* str, size_t len)
     {
-        return internal::getRawStr(std::string(str, len));
+        return internal::getRawStr(str, len);
     }
 
 } // namespace literals
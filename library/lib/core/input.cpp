@@ -50,6 +50,9 @@ TouchState InputManager::computeTouchState(RawTouchState currentTouch, TouchStat
         state.position = lastFrameState.position;
     else
         state.position = currentTouch.position;
+
+    // Released touches have no raw sample, stamp them with the time the release was noticed
+    state.timestamp = currentTouch.timestamp != 0 ? currentTouch.timestamp : getTimeUsec();
     return state;
 }
 
@@ -63,6 +66,7 @@ MouseState InputManager::computeMouseState(RawMouseState currentTouch, MouseStat
     state.leftButton   = getPhase(lastFrameState.leftButton, currentTouch.leftButton);
     state.middleButton = getPhase(lastFrameState.middleButton, currentTouch.middleButton);
     state.rightButton  = getPhase(lastFrameState.rightButton, currentTouch.rightButton);
+    state.timestamp    = currentTouch.timestamp != 0 ? currentTouch.timestamp : getTimeUsec();
     return state;
 }
 
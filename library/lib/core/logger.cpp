@@ -1,6 +1,5 @@
 /*
-    Copyright 2019 natinusala
-    Copyright 2019 p-sam
+    Copyright 2021 natinusala
 
     Licensed under the Apache License, Version 2.0 (the "License");
     you may not use this file except in compliance with the License.
@@ -19,13 +18,194 @@
 #include <stdio.h>
 
 #include <borealis/core/logger.hpp>
+#include <chrono>
+#include <cstdlib>
+
+// Amount of messages the ring buffer can hold, must be a power of two
+#define RING_SIZE 512
+
+// Longest time the logger thread sleeps for, a notification can be missed
+#define DRAIN_PERIOD_MS 10
 
 namespace brls
 {
 
+// Slot i is free for the lap n when its sequence is 2n, written when it's 2n + 1
+static LogMessage ring[RING_SIZE];
+
+static const char* PREFIXES[] = { "ERROR", "WARNING", "INFO", "DEBUG" };
+static const char* COLORS[]   = { "[0;31m", "[0;33m", "[0;34m", "[0;32m" };
+
 void Logger::setLogLevel(LogLevel newLogLevel)
 {
     Logger::logLevel = newLogLevel;
 }
 
+Event<std::string_view>::Subscription Logger::subscribe(Event<std::string_view>::Callback callback)
+{
+    std::lock_guard<std::recursive_mutex> guard(logEventMutex);
+    return logEvent.subscribe(callback);
+}
+
+void Logger::unsubscribe(Event<std::string_view>::Subscription subscription)
+{
+    std::lock_guard<std::recursive_mutex> guard(logEventMutex);
+    logEvent.unsubscribe(subscription);
+}
+
+void Logger::start()
+{
+    if (running)
+        return;
+
+    // Stop the thread before it's destroyed if the application never gets to exit()
+    static std::once_flag atexitFlag;
+    std::call_once(atexitFlag, [] { std::atexit(Logger::stop); });
+
+    thread   = std::thread(Logger::loop);
+    threadId = thread.get_id();
+
+    // Published after the thread ID, for the logger thread to recognise itself
+    // as soon as producers start using the ring buffer
+    running = true;
+}
+
+void Logger::stop()
+{
+    if (!running)
+        return;
+
+    running = false;
+    threadCondition.notify_one();
+    thread.join();
+    threadId = std::thread::id();
+
+    // Messages committed while the thread was stopping, and the ones
+    // still being written by producers that claimed a slot before it did
+    while (producers.load() > 0 || dequeuePosition.load() != enqueuePosition.load())
+    {
+        if (!Logger::drain())
+            std::this_thread::yield();
+    }
+
+    fflush(stdout);
+}
+
+void Logger::flush()
+{
+    if (!running || std::this_thread::get_id() == threadId.load())
+    {
+        fflush(stdout);
+        return;
+    }
+
+    size_t position = enqueuePosition.load();
+    threadCondition.notify_one();
+
+    while (running && dequeuePosition.load() < position)
+        std::this_thread::yield();
+}
+
+LogMessage* Logger::beginMessage(LogLevel logLevel)
+{
+    // Announced before checking running, so that stop() either sees
+    // this producer or this producer sees the logger stopping
+    producers.fetch_add(1);
+
+    // Written right away from the logger thread itself (subscribers logging),
+    // as it could be waiting for its own ring buffer to have room
+    while (running && std::this_thread::get_id() != threadId.load())
+    {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        LogMessage* slot = &ring[position & (RING_SIZE - 1)];
+        size_t sequence  = slot->sequence.load(std::memory_order_acquire);
+        size_t free      = (position / RING_SIZE) * 2;
+
+        if (sequence == free)
+        {
+            if (!enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                continue;
+
+            slot->level  = logLevel;
+            slot->length = 0;
+            return slot;
+        }
+        else if (sequence < free)
+        {
+            // Full: wait for the logger thread to catch up
+            threadCondition.notify_one();
+            std::this_thread::yield();
+        }
+    }
+
+    producers.fetch_sub(1);
+
+    LogMessage* message = new LogMessage();
+    message->level      = logLevel;
+    return message;
+}
+
+void Logger::commitMessage(LogMessage* message)
+{
+    if (message < ring || message >= ring + RING_SIZE)
+    {
+        Logger::write(message);
+        delete message;
+        return;
+    }
+
+    message->sequence.fetch_add(1, std::memory_order_release);
+    producers.fetch_sub(1, std::memory_order_release);
+}
+
+void Logger::loop()
+{
+    // Wait for start() to publish the thread ID
+    while (!running)
+        std::this_thread::yield();
+
+    while (running)
+    {
+        if (Logger::drain())
+            continue;
+
+        fflush(stdout);
+
+        std::unique_lock<std::mutex> lock(threadMutex);
+        threadCondition.wait_for(lock, std::chrono::milliseconds(DRAIN_PERIOD_MS));
+    }
+}
+
+bool Logger::drain()
+{
+    size_t position  = dequeuePosition.load(std::memory_order_relaxed);
+    LogMessage* slot = &ring[position & (RING_SIZE - 1)];
+
+    // Not written yet (or not even claimed)
+    if (slot->sequence.load(std::memory_order_acquire) != (position / RING_SIZE) * 2 + 1)
+        return false;
+
+    Logger::write(slot);
+
+    slot->overflow.clear();
+    slot->sequence.fetch_add(1, std::memory_order_release);
+    dequeuePosition.store(position + 1, std::memory_order_release);
+
+    return true;
+}
+
+void Logger::write(const LogMessage* message)
+{
+    std::string_view text = message->getText();
+
+    fmt::print("\033{}[{}]\033[0m {}\n", COLORS[(size_t)message->level], PREFIXES[(size_t)message->level], fmt::string_view(text.data(), text.size()));
+
+#ifdef __MINGW32__
+    fflush(0);
+#endif
+
+    std::lock_guard<std::recursive_mutex> guard(logEventMutex);
+    logEvent.fire(text);
+}
+
 } // namespace brls
@@ -0,0 +1,191 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/application.hpp>
+#include <borealis/core/platform_status.hpp>
+#include <borealis/core/thread.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+
+namespace brls
+{
+
+BatteryStatus PlatformStatus::getBattery()
+{
+    PlatformStatus::start();
+    return battery;
+}
+
+WirelessStatus PlatformStatus::getWireless()
+{
+    PlatformStatus::start();
+    return wireless;
+}
+
+std::string PlatformStatus::getTime()
+{
+    PlatformStatus::start();
+    return time;
+}
+
+Event<BatteryStatus>* PlatformStatus::getBatteryChangeEvent()
+{
+    PlatformStatus::start();
+    return &batteryChangeEvent;
+}
+
+Event<WirelessStatus>* PlatformStatus::getWirelessChangeEvent()
+{
+    PlatformStatus::start();
+    return &wirelessChangeEvent;
+}
+
+Event<std::string>* PlatformStatus::getTimeChangeEvent()
+{
+    PlatformStatus::start();
+    return &timeChangeEvent;
+}
+
+void PlatformStatus::start()
+{
+    if (started)
+        return;
+
+    started = true;
+
+    // First values are needed right away by the widgets
+    PlatformStatus::poll(false);
+
+    battery  = polledBattery;
+    wireless = polledWireless;
+    time     = polledTime;
+
+    // Stop the thread before it's destroyed if the application never gets to exit()
+    std::atexit(PlatformStatus::stop);
+
+    running = true;
+    thread  = std::thread(PlatformStatus::loop);
+}
+
+void PlatformStatus::stop()
+{
+    if (!running)
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(threadMutex);
+        running = false;
+    }
+
+    threadCondition.notify_one();
+    thread.join();
+}
+
+void PlatformStatus::loop()
+{
+    std::unique_lock<std::mutex> lock(threadMutex);
+
+    while (running)
+    {
+        // Wake up right after the next second, for the clock not to lag behind
+        auto now  = std::chrono::system_clock::now();
+        auto next = std::chrono::time_point_cast<std::chrono::seconds>(now) + std::chrono::seconds(1);
+
+        if (threadCondition.wait_until(lock, next, [] { return !running; }))
+            break;
+
+        lock.unlock();
+        PlatformStatus::poll(true);
+        lock.lock();
+    }
+}
+
+void PlatformStatus::poll(bool notify)
+{
+    Platform* platform = Application::getPlatform();
+
+    BatteryStatus newBattery;
+    if (platform->canShowBatteryLevel())
+    {
+        newBattery.level    = platform->getBatteryLevel();
+        newBattery.charging = platform->isBatteryCharging();
+    }
+
+    WirelessStatus newWireless;
+    newWireless.connected = platform->hasWirelessConnection();
+    newWireless.level     = newWireless.connected ? platform->getWirelessLevel() : 0;
+
+    // std::localtime returns a buffer shared with the whole process, use the reentrant variants
+    std::time_t timeNow = std::time(nullptr);
+    std::tm localTime;
+#ifdef _WIN32
+    bool timeValid = localtime_s(&localTime, &timeNow) == 0;
+#else
+    bool timeValid = localtime_r(&timeNow, &localTime) != nullptr;
+#endif
+
+    // Keep the previous time if the current one cannot be converted
+    std::string newTime = polledTime;
+    if (timeValid)
+    {
+        char buffer[16];
+        std::strftime(buffer, sizeof(buffer), "%H:%M:%S", &localTime);
+        newTime = buffer;
+    }
+
+    // Only wake the main thread up for the values that changed
+    if (newBattery != polledBattery)
+    {
+        polledBattery = newBattery;
+
+        if (notify)
+        {
+            brls::sync([newBattery] {
+                battery = newBattery;
+                batteryChangeEvent.fire(newBattery);
+            });
+        }
+    }
+
+    if (newWireless != polledWireless)
+    {
+        polledWireless = newWireless;
+
+        if (notify)
+        {
+            brls::sync([newWireless] {
+                wireless = newWireless;
+                wirelessChangeEvent.fire(newWireless);
+            });
+        }
+    }
+
+    if (newTime != polledTime)
+    {
+        polledTime = newTime;
+
+        if (notify)
+        {
+            brls::sync([newTime] {
+                time = newTime;
+                timeChangeEvent.fire(newTime);
+            });
+        }
+    }
+}
+
+} // namespace brls
@@ -0,0 +1,80 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/logger.hpp>
+#include <borealis/core/profiler.hpp>
+
+// Weight of the new value in the moving average
+#define AVERAGE_WEIGHT 0.05
+
+namespace brls
+{
+
+void ProfilerMetric::record(double value)
+{
+    this->last    = value;
+    this->average = this->samples == 0 ? value : this->average + (value - this->average) * AVERAGE_WEIGHT;
+
+    if (this->samples == 0 || value > this->max)
+        this->max = value;
+
+    this->samples++;
+}
+
+void ProfilerMetric::reset()
+{
+    this->last    = 0;
+    this->max     = 0;
+    this->average = 0;
+    this->samples = 0;
+}
+
+ProfilerMetric* Profiler::getMetric(std::string name)
+{
+    std::lock_guard<std::mutex> guard(metricsMutex);
+
+    for (ProfilerMetric* metric : metrics)
+    {
+        if (metric->name == name)
+            return metric;
+    }
+
+    ProfilerMetric* metric = new ProfilerMetric();
+    metric->name           = name;
+    metrics.push_back(metric);
+    return metric;
+}
+
+std::vector<ProfilerMetric*> Profiler::getMetrics()
+{
+    std::lock_guard<std::mutex> guard(metricsMutex);
+    return metrics;
+}
+
+void Profiler::reset()
+{
+    std::lock_guard<std::mutex> guard(metricsMutex);
+    for (ProfilerMetric* metric : metrics)
+        metric->reset();
+}
+
+void Profiler::dump()
+{
+    for (ProfilerMetric* metric : Profiler::getMetrics())
+        Logger::info("{}: last={} avg={:.2f} max={} ({} samples)", metric->name, metric->last, metric->average, metric->max, metric->samples);
+}
+
+} // namespace brls
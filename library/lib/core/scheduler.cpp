@@ -0,0 +1,223 @@
+/*
+    Copyright 2021 XITRIX
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/scheduler.hpp>
+
+namespace brls
+{
+
+TimerHandle Scheduler::schedule(Time delay, const std::function<void()>& func)
+{
+    return scheduleAt(getTimeUsec() + delay * 1000, func);
+}
+
+TimerHandle Scheduler::scheduleAt(Time deadline, const std::function<void()>& func)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    uint32_t index;
+    if (!m_free_slots.empty())
+    {
+        index = m_free_slots.back();
+        m_free_slots.pop_back();
+    }
+    else
+    {
+        index = (uint32_t)m_slots.size();
+        m_slots.emplace_back();
+    }
+
+    Slot& slot    = m_slots[index];
+    slot.deadline = deadline;
+    slot.sequence = m_sequence++;
+    slot.func     = func;
+
+    m_heap.push_back(index);
+    slot.heapIndex = m_heap.size() - 1;
+    sift_up(slot.heapIndex);
+
+    TimerHandle handle;
+    handle.index      = index;
+    handle.generation = slot.generation;
+    return handle;
+}
+
+bool Scheduler::cancel(TimerHandle handle)
+{
+    std::function<void()> func;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if (!handle.isValid() || handle.index >= m_slots.size() || m_slots[handle.index].generation != handle.generation)
+            return false;
+
+        Slot& slot = m_slots[handle.index];
+        func       = std::move(slot.func); // destroyed outside of the lock
+        remove_at(slot.heapIndex);
+    }
+
+    return true;
+}
+
+bool Scheduler::isPending(TimerHandle handle)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return handle.isValid() && handle.index < m_slots.size() && m_slots[handle.index].generation == handle.generation;
+}
+
+bool Scheduler::getNextDeadline(Time* deadline)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_heap.empty())
+        return false;
+
+    *deadline = m_slots[m_heap.front()].deadline;
+    return true;
+}
+
+size_t Scheduler::getPendingCount()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_heap.size();
+}
+
+void Scheduler::rebase(Time offset)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    // Every deadline moves by the same offset, the heap stays ordered
+    for (uint32_t index : m_heap)
+        m_slots[index].deadline += offset;
+}
+
+void Scheduler::runDueTimers()
+{
+    Time now;
+    uint64_t lastSequence;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if (m_heap.empty())
+            return;
+
+        now = getTimeUsec();
+        if (m_slots[m_heap.front()].deadline > now)
+            return;
+
+        lastSequence = m_sequence;
+    }
+
+    // Timers are taken one by one so that a timer cancelled by
+    // the one running before it is never executed
+    while (true)
+    {
+        std::function<void()> func;
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            if (m_heap.empty())
+                return;
+
+            Slot& slot = m_slots[m_heap.front()];
+            if (slot.deadline > now || slot.sequence >= lastSequence)
+                return;
+
+            func = std::move(slot.func);
+            remove_at(0);
+        }
+
+        func();
+    }
+}
+
+bool Scheduler::is_before(uint32_t a, uint32_t b)
+{
+    const Slot& slotA = m_slots[a];
+    const Slot& slotB = m_slots[b];
+
+    if (slotA.deadline != slotB.deadline)
+        return slotA.deadline < slotB.deadline;
+
+    return slotA.sequence < slotB.sequence;
+}
+
+void Scheduler::place(size_t position, uint32_t slot)
+{
+    m_heap[position]        = slot;
+    m_slots[slot].heapIndex = position;
+}
+
+void Scheduler::sift_up(size_t position)
+{
+    uint32_t slot = m_heap[position];
+    while (position > 0)
+    {
+        size_t parent = (position - 1) / 2;
+        if (!is_before(slot, m_heap[parent]))
+            break;
+
+        place(position, m_heap[parent]);
+        position = parent;
+    }
+
+    place(position, slot);
+}
+
+void Scheduler::sift_down(size_t position)
+{
+    uint32_t slot = m_heap[position];
+    size_t size   = m_heap.size();
+    while (true)
+    {
+        size_t child = position * 2 + 1;
+        if (child >= size)
+            break;
+
+        if (child + 1 < size && is_before(m_heap[child + 1], m_heap[child]))
+            child++;
+
+        if (!is_before(m_heap[child], slot))
+            break;
+
+        place(position, m_heap[child]);
+        position = child;
+    }
+
+    place(position, slot);
+}
+
+void Scheduler::remove_at(size_t position)
+{
+    uint32_t index = m_heap[position];
+
+    // Invalidate the handles pointing to this slot, 0 is reserved for invalid handles
+    Slot& slot = m_slots[index];
+    slot.generation++;
+    if (slot.generation == 0)
+        slot.generation = 1;
+    m_free_slots.push_back(index);
+
+    uint32_t last = m_heap.back();
+    m_heap.pop_back();
+
+    if (position == m_heap.size())
+        return;
+
+    place(position, last);
+    if (position > 0 && is_before(last, m_heap[(position - 1) / 2]))
+        sift_up(position);
+    else
+        sift_down(position);
+}
+
+} // namespace brls
@@ -0,0 +1,296 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/logger.hpp>
+#include <borealis/core/profiler.hpp>
+#include <borealis/core/startup.hpp>
+#include <borealis/core/thread.hpp>
+
+namespace brls
+{
+
+void Startup::begin()
+{
+    std::lock_guard<std::mutex> guard(mutex);
+
+    mainThread = std::this_thread::get_id();
+    startTime  = getCPUTimeUsec();
+}
+
+StartupTaskId Startup::add(std::string name, StartupThread thread, std::function<void()> function, std::vector<StartupTaskId> dependencies, bool blocking)
+{
+    std::lock_guard<std::mutex> guard(mutex);
+
+    StartupTaskId id  = tasks.size();
+    StartupTask& task = tasks.emplace_back();
+
+    task.name     = name;
+    task.thread   = thread;
+    task.function = function;
+
+    // Dependencies always have a lower id: the graph cannot have cycles
+    for (StartupTaskId dependency : dependencies)
+    {
+        if (tasks[dependency].state == StartupTaskState::DONE)
+            continue;
+
+        task.pendingDependencies++;
+        tasks[dependency].dependents.push_back(id);
+    }
+
+    if (blocking && !released)
+    {
+        task.blocking = true;
+        blockingLeft++;
+
+        for (StartupTaskId dependency : dependencies)
+            markBlocking(dependency);
+    }
+
+    // Milestones are only completed by reach()
+    if (thread == StartupThread::MILESTONE)
+        task.pendingDependencies++;
+
+    if (task.pendingDependencies == 0)
+        schedule(id);
+
+    return id;
+}
+
+StartupTaskId Startup::addMilestone(std::string name, bool blocking)
+{
+    return Startup::add(name, StartupThread::MILESTONE, nullptr, {}, blocking);
+}
+
+void Startup::reach(StartupTaskId milestone)
+{
+    Time duration;
+
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+
+        if (tasks[milestone].state == StartupTaskState::DONE)
+            return;
+
+        duration = getCPUTimeUsec() - startTime;
+    }
+
+    // Milestones are timed from the beginning of the startup
+    Startup::complete(milestone, duration);
+}
+
+bool Startup::isDone(StartupTaskId task)
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    return tasks[task].state == StartupTaskState::DONE;
+}
+
+void Startup::wait(StartupTaskId task)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    bool onMainThread = std::this_thread::get_id() == mainThread;
+
+    // Needed right now: the task is blocking from now on
+    if (!released)
+        markBlocking(task);
+
+    while (tasks[task].state != StartupTaskState::DONE)
+    {
+        StartupTaskId next;
+        if (onMainThread && popMainTask(!released, &next))
+        {
+            lock.unlock();
+            Startup::run(next);
+            lock.lock();
+            continue;
+        }
+
+        condition.wait(lock);
+    }
+}
+
+void Startup::waitForBlockingTasks()
+{
+    Time start = getCPUTimeUsec();
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (blockingLeft > 0)
+    {
+        StartupTaskId next;
+        if (popMainTask(true, &next))
+        {
+            lock.unlock();
+            Startup::run(next);
+            lock.lock();
+            continue;
+        }
+
+        condition.wait(lock);
+    }
+
+    released    = true;
+    blockedTime = getCPUTimeUsec() - start;
+}
+
+void Startup::onFirstFrame()
+{
+    Time firstFrameTime;
+    size_t pending = 0;
+
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+
+        if (painted)
+            return;
+
+        painted        = true;
+        firstFrameTime = getCPUTimeUsec() - startTime;
+
+        // Main thread tasks left for after the first frame
+        for (StartupTaskId id : mainQueue)
+            Threading::sync([id] { Startup::run(id); }, SyncPriority::IDLE);
+
+        mainQueue.clear();
+
+        for (StartupTask& task : tasks)
+        {
+            if (task.state != StartupTaskState::DONE)
+                pending++;
+        }
+    }
+
+    Profiler::getMetric("startup/firstFrameUsec")->record(firstFrameTime);
+    Profiler::getMetric("startup/blockedUsec")->record(blockedTime);
+
+    Logger::info("First frame drawn after {}ms ({}ms waiting for the assets), {} startup tasks still loading", firstFrameTime / 1000, blockedTime / 1000, pending);
+}
+
+void Startup::run(StartupTaskId id)
+{
+    std::function<void()> function;
+
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+
+        // Main thread tasks can be queued twice, only run them once
+        StartupTask& task = tasks[id];
+        if (task.state != StartupTaskState::READY)
+            return;
+
+        task.state = StartupTaskState::RUNNING;
+        function   = std::move(task.function);
+    }
+
+    Time start = getCPUTimeUsec();
+
+    if (function)
+        function();
+
+    Startup::complete(id, getCPUTimeUsec() - start);
+}
+
+void Startup::complete(StartupTaskId id, Time duration)
+{
+    std::string name;
+
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+
+        StartupTask& task = tasks[id];
+        task.state        = StartupTaskState::DONE;
+        name              = task.name;
+
+        if (task.blocking)
+            blockingLeft--;
+
+        for (StartupTaskId dependent : task.dependents)
+        {
+            if (--tasks[dependent].pendingDependencies == 0)
+                schedule(dependent);
+        }
+
+        condition.notify_all();
+    }
+
+    BRLS_LOG_DEBUG("Startup task {} done in {}us", name, duration);
+
+    // Metrics are recorded from the main thread
+    Threading::sync([name, duration] {
+        Profiler::getMetric("startup/" + name + "Usec")->record(duration);
+    });
+}
+
+void Startup::schedule(StartupTaskId id)
+{
+    StartupTask& task = tasks[id];
+    task.state        = StartupTaskState::READY;
+
+    switch (task.thread)
+    {
+        case StartupThread::WORKER:
+            Threading::async([id] { Startup::run(id); }, task.blocking ? TaskPriority::HIGH : TaskPriority::LOW);
+            break;
+        case StartupThread::MAIN:
+            if (painted)
+                Threading::sync([id] { Startup::run(id); }, SyncPriority::IDLE);
+            else
+                mainQueue.push_back(id);
+
+            condition.notify_all();
+            break;
+        case StartupThread::MILESTONE:
+            break;
+    }
+}
+
+void Startup::markBlocking(StartupTaskId id)
+{
+    StartupTask& task = tasks[id];
+
+    if (task.blocking || task.state == StartupTaskState::DONE)
+        return;
+
+    task.blocking = true;
+    blockingLeft++;
+
+    // The dependencies of a task are the ones it is a dependent of
+    for (StartupTaskId dependency = 0; dependency < id; dependency++)
+    {
+        for (StartupTaskId dependent : tasks[dependency].dependents)
+        {
+            if (dependent == id)
+                markBlocking(dependency);
+        }
+    }
+}
+
+bool Startup::popMainTask(bool blockingOnly, StartupTaskId* id)
+{
+    for (auto it = mainQueue.begin(); it != mainQueue.end(); it++)
+    {
+        if (blockingOnly && !tasks[*it].blocking)
+            continue;
+
+        *id = *it;
+        mainQueue.erase(it);
+        return true;
+    }
+
+    return false;
+}
+
+} // namespace brls
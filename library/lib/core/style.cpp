@@ -128,6 +128,9 @@ static StyleValues styleValues = {
     { "brls/spinner/bar_width_multiplier", 0.06f },
     { "brls/spinner/animation_duration", 1000 },
 
+    // AsyncLayout
+    { "brls/async_layout/spinner_size", 60.0f },
+
     // Dialog
     { "brls/dialog/paddingTopBottom", 65 },
     { "brls/dialog/paddingLeftRight", 115 },
@@ -144,21 +147,23 @@ Style getStyle()
 
 StyleValues::StyleValues(std::initializer_list<std::pair<std::string, float>> list)
 {
-    for (std::pair<std::string, float> metric : list)
-        this->values.insert(metric);
+    for (const std::pair<std::string, float>& metric : list)
+        this->addMetric(metric.first, metric.second);
 }
 
 void StyleValues::addMetric(std::string name, float metric)
 {
-    this->values.insert(std::make_pair(name, metric));
+    if (!this->values.insert(name, metric))
+        fatal("Style metric name \"" + name + "\" collides with another one");
 }
 
-float StyleValues::getMetric(std::string name)
+float StyleValues::getMetric(InternedKey name)
 {
-    if (this->values.count(name) == 0)
-        fatal("Unknown style metric \"" + name + "\"");
+    float* value = this->values.find(name);
+    if (!value)
+        fatal("Unknown style metric \"" + std::string(name.getName()) + "\"");
 
-    return this->values[name];
+    return *value;
 }
 
 Style::Style(StyleValues* values)
@@ -166,7 +171,7 @@ Style::Style(StyleValues* values)
 {
 }
 
-float Style::getMetric(std::string name)
+float Style::getMetric(InternedKey name)
 {
     return this->values->getMetric(name);
 }
@@ -176,7 +181,7 @@ void Style::addMetric(std::string name, float metric)
     return this->values->addMetric(name, metric);
 }
 
-float Style::operator[](std::string name)
+float Style::operator[](InternedKey name)
 {
     return this->getMetric(name);
 }
@@ -0,0 +1,177 @@
+/*
+    Copyright 2021 XITRIX
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/profiler.hpp>
+#include <borealis/core/sync_queue.hpp>
+
+// Amount of nodes allocated at once when the pool is empty
+#define POOL_CHUNK_SIZE 64
+
+namespace brls
+{
+
+// Nodes cached by the current thread, given back to the pool when the thread exits
+struct SyncTaskCache
+{
+    SyncTaskNode* first = nullptr;
+
+    ~SyncTaskCache()
+    {
+        if (!this->first)
+            return;
+
+        SyncTaskNode* last = this->first;
+        while (last->poolNext)
+            last = last->poolNext;
+
+        SyncTaskPool::release(this->first, last);
+    }
+};
+
+static thread_local SyncTaskCache cache;
+
+SyncTaskNode* SyncTaskPool::allocate()
+{
+    // Take every released node at once: there is no single pop,
+    // so nodes can't be recycled under our feet (ABA)
+    if (!cache.first)
+        cache.first = releasedNodes.exchange(nullptr, std::memory_order_acquire);
+
+    if (!cache.first)
+    {
+        // Pool nodes are never freed, the pool only grows to the highest amount of pending tasks
+        SyncTaskNode* chunk = new SyncTaskNode[POOL_CHUNK_SIZE];
+        for (size_t i = 0; i < POOL_CHUNK_SIZE - 1; i++)
+            chunk[i].poolNext = &chunk[i + 1];
+
+        cache.first = chunk;
+    }
+
+    SyncTaskNode* node = cache.first;
+    cache.first        = node->poolNext;
+    node->poolNext     = nullptr;
+    return node;
+}
+
+void SyncTaskPool::release(SyncTaskNode* first, SyncTaskNode* last)
+{
+    SyncTaskNode* released = releasedNodes.load(std::memory_order_relaxed);
+    do
+    {
+        last->poolNext = released;
+    } while (!releasedNodes.compare_exchange_weak(released, first, std::memory_order_release, std::memory_order_relaxed));
+}
+
+SyncQueue::SyncQueue()
+    : head(&stub)
+    , tail(&stub)
+{
+}
+
+void SyncQueue::pushNode(SyncTaskNode* node)
+{
+    this->depth.fetch_add(1, std::memory_order_relaxed);
+
+    node->next.store(nullptr, std::memory_order_relaxed);
+    SyncTaskNode* previous = this->head.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+}
+
+SyncTaskNode* SyncQueue::popNode()
+{
+    SyncTaskNode* tail = this->tail;
+    SyncTaskNode* next = tail->next.load(std::memory_order_acquire);
+
+    if (tail == &this->stub)
+    {
+        if (!next)
+            return nullptr;
+
+        this->tail = next;
+        tail       = next;
+        next       = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next)
+    {
+        this->tail = next;
+        return tail;
+    }
+
+    // A producer is in the middle of a push, its node will be popped next time
+    if (tail != this->head.load(std::memory_order_acquire))
+        return nullptr;
+
+    // Last node of the queue: put the stub back behind it to be able to pop it
+    this->pushNode(&this->stub);
+    this->depth.fetch_sub(1, std::memory_order_relaxed);
+
+    next = tail->next.load(std::memory_order_acquire);
+    if (next)
+    {
+        this->tail = next;
+        return tail;
+    }
+
+    return nullptr;
+}
+
+size_t SyncQueue::drain(Time deadline, ProfilerMetric* latencyMetric)
+{
+    // Tasks pushed after that node are left for the next drain
+    SyncTaskNode* last = this->head.load(std::memory_order_acquire);
+    if (last == &this->stub)
+        return 0;
+
+    SyncTaskNode* releasedFirst = nullptr;
+    SyncTaskNode* releasedLast  = nullptr;
+    size_t count                = 0;
+
+    while (true)
+    {
+        Time now = deadline != 0 || latencyMetric ? getCPUTimeUsec() : 0;
+        if (deadline != 0 && count > 0 && now >= deadline)
+            break;
+
+        SyncTaskNode* node = this->popNode();
+        if (!node)
+            break;
+
+        this->depth.fetch_sub(1, std::memory_order_relaxed);
+
+        if (latencyMetric)
+            latencyMetric->record(now - node->timestamp);
+
+        node->func();
+        node->func.reset();
+        count++;
+
+        node->poolNext = releasedFirst;
+        releasedFirst  = node;
+        if (!releasedLast)
+            releasedLast = node;
+
+        if (node == last)
+            break;
+    }
+
+    if (releasedFirst)
+        SyncTaskPool::release(releasedFirst, releasedLast);
+
+    return count;
+}
+
+} // namespace brls
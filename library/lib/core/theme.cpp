@@ -142,21 +142,23 @@ static Theme darkTheme(&darkThemeValues);
 
 ThemeValues::ThemeValues(std::initializer_list<std::pair<std::string, NVGcolor>> list)
 {
-    for (std::pair<std::string, NVGcolor> color : list)
-        this->values.insert(color);
+    for (const std::pair<std::string, NVGcolor>& color : list)
+        this->addColor(color.first, color.second);
 }
 
 void ThemeValues::addColor(std::string name, NVGcolor color)
 {
-    this->values.insert(std::make_pair(name, color));
+    if (!this->values.insert(name, color))
+        fatal("Theme value name \"" + name + "\" collides with another one");
 }
 
-NVGcolor ThemeValues::getColor(std::string name)
+NVGcolor ThemeValues::getColor(InternedKey name)
 {
-    if (this->values.count(name) == 0)
-        fatal("Unknown theme value \"" + name + "\"");
+    NVGcolor* value = this->values.find(name);
+    if (!value)
+        fatal("Unknown theme value \"" + std::string(name.getName()) + "\"");
 
-    return this->values[name];
+    return *value;
 }
 
 Theme::Theme(ThemeValues* values)
@@ -164,7 +166,7 @@ Theme::Theme(ThemeValues* values)
 {
 }
 
-NVGcolor Theme::getColor(std::string name)
+NVGcolor Theme::getColor(InternedKey name) const
 {
     return this->values->getColor(name);
 }
@@ -174,7 +176,7 @@ void Theme::addColor(std::string name, NVGcolor color)
     return this->values->addColor(name, color);
 }
 
-NVGcolor Theme::operator[](std::string name)
+NVGcolor Theme::operator[](InternedKey name) const
 {
     return this->getColor(name);
 }
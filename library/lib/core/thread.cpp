@@ -14,123 +14,262 @@
     limitations under the License.
 */
 
-#include <libretro-common/retro_timers.h>
-
+#include <borealis/core/profiler.hpp>
 #include <borealis/core/thread.hpp>
+#include <borealis/core/time.hpp>
+#include <cstdlib>
+#include <mutex>
 
 namespace brls
 {
 
-static pthread_t task_loop_thread;
-
 Threading::Threading()
 {
     start_task_loop();
 }
 
-void sync(const std::function<void()>& func)
-{
-    Threading::sync(func);
-}
-
 void async(const std::function<void()>& task)
 {
     Threading::async(task);
 }
 
-void delay(long milliseconds, const std::function<void()>& func)
+void async(const std::function<void()>& task, TaskPriority priority)
 {
-    Threading::delay(milliseconds, func);
+    Threading::async(task, priority);
 }
 
-void Threading::sync(const std::function<void()>& func)
+TimerHandle delay(long milliseconds, const std::function<void()>& func)
 {
-    std::lock_guard<std::mutex> guard(m_sync_mutex);
-    m_sync_functions.push_back(func);
+    return Threading::delay(milliseconds, func);
 }
 
-void Threading::async(const std::function<void()>& task)
+bool cancelDelay(TimerHandle handle)
 {
-    std::lock_guard<std::mutex> guard(m_async_mutex);
-    m_async_tasks.push_back(task);
+    return Threading::cancelDelay(handle);
 }
 
-void Threading::delay(long milliseconds, const std::function<void()>& func)
+void TaskQueue::push(const std::function<void()>& task, TaskPriority priority)
 {
-    std::lock_guard<std::mutex> guard(m_delay_mutex);
-    DelayOperation operation;
-    operation.startPoint        = std::chrono::high_resolution_clock::now();
-    operation.delayMilliseconds = milliseconds;
-    operation.func              = func;
-    m_delay_tasks.push_back(operation);
+    std::lock_guard<std::mutex> guard(mutex);
+    tasks[(size_t)priority].push_back(task);
 }
 
-void Threading::performSyncTasks()
+bool TaskQueue::pop(std::function<void()>* task)
 {
-    m_sync_mutex.lock();
-    auto local = m_sync_functions;
-    m_sync_functions.clear();
-    m_sync_mutex.unlock();
+    std::lock_guard<std::mutex> guard(mutex);
+    for (auto& queue : tasks)
+    {
+        if (queue.empty())
+            continue;
 
-    for (auto& f : local)
-        f();
+        *task = std::move(queue.front());
+        queue.pop_front();
+        return true;
+    }
 
-    m_delay_mutex.lock();
-    auto delay_local = m_delay_tasks;
-    m_delay_tasks.clear();
-    m_delay_mutex.unlock();
+    return false;
+}
 
-    for (auto& d : delay_local)
+bool TaskQueue::steal(std::function<void()>* task)
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    for (size_t i = (size_t)TaskPriority::_PRIORITY_MAX; i > 0; i--)
     {
-        auto timeNow  = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(timeNow - d.startPoint).count();
+        auto& queue = tasks[i - 1];
+        if (queue.empty())
+            continue;
 
-        if (duration >= d.delayMilliseconds)
-            d.func();
-        else
-        {
-            m_delay_mutex.lock();
-            m_delay_tasks.push_back(d);
-            m_delay_mutex.unlock();
-        }
+        *task = std::move(queue.back());
+        queue.pop_back();
+        return true;
+    }
+
+    return false;
+}
+
+void TaskQueue::clear()
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    for (auto& queue : tasks)
+        queue.clear();
+}
+
+void Threading::async(const std::function<void()>& task, TaskPriority priority)
+{
+    // Keep tasks spawned by a worker close to it, idle workers will steal them if needed
+    if (work_stealing && current_worker >= 0 && (size_t)current_worker < m_worker_tasks.size())
+        m_worker_tasks[current_worker]->push(task, priority);
+    else
+        m_async_tasks.push(task, priority);
+
+    {
+        std::lock_guard<std::mutex> guard(m_wakeup_mutex);
+        m_pending_tasks++;
     }
+    m_wakeup_condition.notify_one();
+}
+
+TimerHandle Threading::delay(long milliseconds, const std::function<void()>& func)
+{
+    return Scheduler::schedule(milliseconds, func);
+}
+
+bool Threading::cancelDelay(TimerHandle handle)
+{
+    return Scheduler::cancel(handle);
+}
+
+void Threading::performSyncTasks()
+{
+    static ProfilerMetric* queueDepthMetric = Profiler::getMetric("sync/queueDepth");
+    static ProfilerMetric* drainTimeMetric  = Profiler::getMetric("sync/drainTimeUsec");
+    static ProfilerMetric* carriedMetric    = Profiler::getMetric("sync/carriedOver");
+    static ProfilerMetric* latencyMetrics[] = {
+        Profiler::getMetric("sync/critical/latencyUsec"),
+        Profiler::getMetric("sync/normal/latencyUsec"),
+        Profiler::getMetric("sync/idle/latencyUsec"),
+    };
+
+    queueDepthMetric->record(getSyncQueueDepth());
+
+    Time drainStart = getCPUTimeUsec();
+    Time deadline   = sync_budget > 0 ? drainStart + sync_budget : 0;
+
+    SyncQueue& critical = m_sync_queues[(size_t)SyncPriority::CRITICAL];
+    SyncQueue& normal   = m_sync_queues[(size_t)SyncPriority::NORMAL];
+    SyncQueue& idle     = m_sync_queues[(size_t)SyncPriority::IDLE];
+
+    critical.drain(0, latencyMetrics[(size_t)SyncPriority::CRITICAL]);
+    normal.drain(deadline, latencyMetrics[(size_t)SyncPriority::NORMAL]);
+
+    // Idle functions only get what's left of the frame budget
+    if (normal.getDepth() == 0 && (deadline == 0 || getCPUTimeUsec() < deadline))
+        idle.drain(deadline, latencyMetrics[(size_t)SyncPriority::IDLE]);
+
+    drainTimeMetric->record(getCPUTimeUsec() - drainStart);
+    carriedMetric->record(normal.getDepth() + idle.getDepth());
+
+    Scheduler::runDueTimers();
+}
+
+void Threading::setSyncBudget(Time budget)
+{
+    sync_budget = budget;
+}
+
+Time Threading::getSyncBudget()
+{
+    return sync_budget;
+}
+
+size_t Threading::getSyncQueueDepth()
+{
+    size_t depth = 0;
+    for (SyncQueue& queue : m_sync_queues)
+        depth += queue.getDepth();
+
+    return depth;
+}
+
+void Threading::setWorkersCount(unsigned count)
+{
+    workers_count = count;
+}
+
+size_t Threading::getWorkersCount()
+{
+    return m_workers.size();
+}
+
+void Threading::setWorkStealing(bool enabled)
+{
+    work_stealing = enabled;
 }
 
 void Threading::start()
 {
+    // Join the workers before they're destroyed if the application never gets to exit()
+    static std::once_flag atexitFlag;
+    std::call_once(atexitFlag, [] { std::atexit(Threading::stop); });
+
     start_task_loop();
 }
 
 void Threading::stop()
 {
-    task_loop_active = false;
-    pthread_join(task_loop_thread, NULL);
+    {
+        std::lock_guard<std::mutex> guard(m_wakeup_mutex);
+        task_loop_active = false;
+    }
+    m_wakeup_condition.notify_all();
+
+    for (std::thread& worker : m_workers)
+        worker.join();
+
+    m_workers.clear();
+    m_worker_tasks.clear();
+    m_async_tasks.clear();
+    m_pending_tasks = 0;
+}
+
+bool Threading::take_task(int worker, std::function<void()>* task)
+{
+    // Own tasks first, then the shared queue, then other workers' tasks
+    if (!m_worker_tasks[worker]->pop(task) && !m_async_tasks.pop(task))
+    {
+        bool stolen = false;
+        for (size_t i = 1; i < m_worker_tasks.size() && !stolen; i++)
+            stolen = m_worker_tasks[(worker + i) % m_worker_tasks.size()]->steal(task);
+
+        if (!stolen)
+            return false;
+    }
+
+    std::lock_guard<std::mutex> guard(m_wakeup_mutex);
+    m_pending_tasks--;
+    return true;
 }
 
-void* Threading::task_loop(void* a)
+void Threading::task_loop(int worker)
 {
+    current_worker = worker;
+
+    std::function<void()> task;
     while (task_loop_active)
     {
-        std::vector<std::function<void()>> m_tasks_copy;
-        {
-            std::lock_guard<std::mutex> guard(m_async_mutex);
-            m_tasks_copy = m_async_tasks;
-            m_async_tasks.clear();
-        }
-
-        for (auto task : m_tasks_copy)
+        if (take_task(worker, &task))
         {
             task();
+            task = nullptr;
+            continue;
         }
 
-        retro_sleep(500);
+        // Sleep until a task is enqueued, pending tasks are counted under
+        // the same lock so that no wakeup can be missed
+        std::unique_lock<std::mutex> lock(m_wakeup_mutex);
+        m_wakeup_condition.wait(lock, [] { return m_pending_tasks > 0 || !task_loop_active; });
     }
-    return NULL;
 }
 
 void Threading::start_task_loop()
 {
-    pthread_create(&task_loop_thread, NULL, task_loop, NULL);
+    if (task_loop_active)
+        return;
+
+    unsigned count = workers_count;
+    if (count == 0)
+    {
+        unsigned hardwareThreads = std::thread::hardware_concurrency();
+        count                    = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    task_loop_active = true;
+
+    for (unsigned i = 0; i < count; i++)
+        m_worker_tasks.push_back(std::make_unique<TaskQueue>());
+
+    for (unsigned i = 0; i < count; i++)
+        m_workers.emplace_back(task_loop, (int)i);
 }
 
 } // namespace brls
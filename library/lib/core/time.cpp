@@ -14,35 +14,113 @@
     limitations under the License.
 */
 
+#include <borealis/core/profiler.hpp>
+#include <borealis/core/scheduler.hpp>
 #include <borealis/core/time.hpp>
 
 namespace brls
 {
 
+Clock* Clock::getCurrent()
+{
+    static SystemClock systemClock;
+
+    Clock* clock = Clock::current.load(std::memory_order_acquire);
+    return clock ? clock : &systemClock;
+}
+
+void Clock::setCurrent(Clock* clock)
+{
+    Clock* previous  = Clock::getCurrent();
+    Time previousNow = previous->now();
+
+    Clock::current.store(clock, std::memory_order_release);
+    Clock::generation++;
+
+    // Pending timers keep the same time left before their deadline on the new clock
+    Scheduler::rebase(Clock::getCurrent()->now() - previousNow);
+}
+
+unsigned Clock::getGeneration()
+{
+    return Clock::generation;
+}
+
+ManualClock::ManualClock(Time time)
+    : time(time)
+{
+}
+
+Time ManualClock::now()
+{
+    return this->time.load(std::memory_order_relaxed);
+}
+
+void ManualClock::advance(Time usec)
+{
+    this->time.fetch_add(usec, std::memory_order_relaxed);
+}
+
+void ManualClock::setTime(Time usec)
+{
+    this->time.store(usec, std::memory_order_relaxed);
+}
+
 void Ticking::updateTickings()
 {
     // Update time
-    static Time previousTime = 0;
+    static Time previousTime           = 0;
+    static unsigned previousGeneration = 0;
 
-    Time currentTime = getCPUTimeUsec() / 1000;
-    Time delta       = previousTime == 0 ? 0 : currentTime - previousTime;
+    // Start over when the clock is replaced, its time has nothing to do with the previous one
+    unsigned generation = Clock::getGeneration();
+    Time currentTime    = getTimeUsec() / 1000;
+    Time delta          = generation != previousGeneration ? 0 : currentTime - previousTime;
 
-    previousTime = currentTime;
+    previousTime       = currentTime;
+    previousGeneration = generation;
+    frameDelta         = delta;
 
-    // Update every running ticking, kill them and execute cb if they are finished
-    // We have to clone the running tickings list to avoid altering it while
-    // in the for loop (so if another ticking is started in a callback or during onUpdate())
-    std::vector<Ticking*> tickings(Ticking::runningTickings);
+    static ProfilerMetric* runningMetric = Profiler::getMetric("tickings/running");
+    runningMetric->record(Ticking::runningCount);
 
-    for (Ticking* ticking : tickings)
+    // Update every running ticking, kill them and execute cb if they are finished
+    // Tickings can be started and stopped from a callback or during onUpdate():
+    // stopping the next ticking moves the cursor past it, and tickings started
+    // during the update wait for the next frame
+    Ticking::updateCount++;
+    Ticking::updating = true;
+
+    Ticking* ticking = Ticking::firstRunning;
+    while (ticking)
     {
-        bool run = ticking->onUpdate(delta);
+        Ticking::nextToUpdate = ticking->nextRunning;
+
+        if (ticking->startUpdate != Ticking::updateCount)
+        {
+            bool run = ticking->onUpdate(delta);
+
+            ticking->tickCallback();
 
-        ticking->tickCallback();
+            if (!run)
+                ticking->stop(true); // will remove the ticking from the running tickings
+        }
 
-        if (!run)
-            ticking->stop(true); // will remove the ticking from Ticking::runningTickings
+        ticking = Ticking::nextToUpdate;
     }
+
+    Ticking::nextToUpdate = nullptr;
+    Ticking::updating     = false;
+}
+
+Time Ticking::getFrameDelta()
+{
+    return Ticking::frameDelta;
+}
+
+size_t Ticking::getRunningCount()
+{
+    return Ticking::runningCount;
 }
 
 void Ticking::start()
@@ -50,7 +128,17 @@ void Ticking::start()
     if (this->running)
         return;
 
-    Ticking::runningTickings.push_back(this);
+    this->previousRunning = Ticking::lastRunning;
+    this->nextRunning     = nullptr;
+    this->startUpdate     = Ticking::updating ? Ticking::updateCount : 0;
+
+    if (Ticking::lastRunning)
+        Ticking::lastRunning->nextRunning = this;
+    else
+        Ticking::firstRunning = this;
+
+    Ticking::lastRunning = this;
+    Ticking::runningCount++;
 
     this->running = true;
 
@@ -67,14 +155,22 @@ void Ticking::stop(bool finished)
     if (!this->running)
         return;
 
-    for (size_t i = 0; i < Ticking::runningTickings.size(); i++)
-    {
-        if (Ticking::runningTickings[i] == this)
-        {
-            Ticking::runningTickings.erase(Ticking::runningTickings.begin() + i);
-            break;
-        }
-    }
+    if (Ticking::nextToUpdate == this)
+        Ticking::nextToUpdate = this->nextRunning;
+
+    if (this->previousRunning)
+        this->previousRunning->nextRunning = this->nextRunning;
+    else
+        Ticking::firstRunning = this->nextRunning;
+
+    if (this->nextRunning)
+        this->nextRunning->previousRunning = this->previousRunning;
+    else
+        Ticking::lastRunning = this->previousRunning;
+
+    this->previousRunning = nullptr;
+    this->nextRunning     = nullptr;
+    Ticking::runningCount--;
 
     this->running = false;
 
@@ -19,53 +19,112 @@
 namespace brls
 {
 
-void Timer::start(Time duration)
+ScheduledTimer::~ScheduledTimer()
 {
-    this->duration = duration;
-    this->start();
+    // Only cancel the timer: the end callback usually captures the owner, which is being destroyed
+    if (this->running)
+        Scheduler::cancel(this->handle);
 }
 
-void Timer::start()
+void ScheduledTimer::start()
 {
-    Ticking::start();
+    if (this->running)
+        return;
+
+    this->running = true;
+    this->schedule();
 }
 
-void Timer::setDuration(Time duration)
+void ScheduledTimer::stop()
+{
+    this->stop(false);
+}
+
+void ScheduledTimer::stop(bool finished)
+{
+    if (!this->running)
+        return;
+
+    Scheduler::cancel(this->handle);
+    this->handle  = TimerHandle();
+    this->running = false;
+
+    this->endCallback(finished);
+}
+
+void ScheduledTimer::setEndCallback(TickingEndCallback endCallback)
+{
+    this->endCallback = endCallback;
+}
+
+bool ScheduledTimer::isRunning()
+{
+    return this->running;
+}
+
+void ScheduledTimer::reschedule()
+{
+    if (!this->running)
+        return;
+
+    Scheduler::cancel(this->handle);
+    this->schedule();
+}
+
+void ScheduledTimer::schedule()
+{
+    this->handle = Scheduler::schedule(this->getDelay(), [this] {
+        this->handle = TimerHandle();
+
+        if (this->onFire())
+        {
+            // The callback may have stopped the timer
+            if (this->running && !this->handle.isValid())
+                this->schedule();
+        }
+        else
+        {
+            this->stop(true);
+        }
+    });
+}
+
+void Timer::start(Time duration)
 {
     this->duration = duration;
+    this->start();
 }
 
-void Timer::onStart()
+void Timer::setDuration(Time duration)
 {
-    this->progress = 0;
+    this->duration = duration;
 }
 
-bool Timer::onUpdate(Time delta)
+void Timer::rewind()
 {
-    this->progress += delta;
-    return this->progress < this->duration;
+    this->reschedule();
 }
 
-void Timer::onReset()
+void Timer::reset()
 {
-    this->progress = 0;
+    this->stop();
     this->duration = 0;
 }
 
-void Timer::onRewind()
+Time Timer::getDelay()
 {
-    this->progress = 0;
+    return this->duration;
 }
 
-void RepeatingTimer::start(Time period)
+bool Timer::onFire()
 {
-    this->period = period;
-    this->start();
+    return false;
 }
 
-void RepeatingTimer::start()
+void RepeatingTimer::start(Time period)
 {
-    Ticking::start();
+    this->period = period;
+    this->start();
 }
 
 void RepeatingTimer::setPeriod(Time period)
@@ -78,22 +137,15 @@ void RepeatingTimer::setCallback(TickingGenericCallback callback)
     this->callback = callback;
 }
 
-void RepeatingTimer::onStart()
+Time RepeatingTimer::getDelay()
 {
-    this->progress = 0;
+    return this->period;
 }
 
-bool RepeatingTimer::onUpdate(Time delta)
+bool RepeatingTimer::onFire()
 {
-    this->progress += delta;
-
-    if (this->progress >= this->period)
-    {
-        this->callback();
-        this->progress = 0;
-    }
-
-    return true; // never stop
+    this->callback();
+    return true;
 }
 
 } // namespace brls
@@ -16,16 +16,17 @@
 
 #include <borealis.hpp>
 
-// TODO: get real FPS
-// Uses to calculate time to play acceleration animation
-#define FPS 60.0f
-
 // Delta from touch starting point to current, when
 // touch will be recognized as pan movement
 #define MAX_DELTA_MOVEMENT 10
 
-// Touch history limit which uses to calculate current pan speed
-#define HISTORY_LIMIT 2
+// Only touch samples younger than that (in microseconds)
+// are used to calculate current pan speed
+#define VELOCITY_WINDOW 100000
+
+// Hard limit of touch samples kept in history, in case
+// the platform reports touches faster than expected
+#define HISTORY_LIMIT 32
 
 // Negative acceleration to calculate
 // time to play acceleration animation
@@ -47,13 +48,15 @@ GestureState PanGestureRecognizer::recognitionLoop(TouchState touch, MouseState
 
     TouchPhase phase = touch.phase;
     Point position   = touch.position;
+    Time timestamp   = touch.timestamp;
     int fingerId     = touch.fingerId;
 
     if (phase == TouchPhase::NONE)
     {
-        fingerId = 0;
-        position = mouse.position;
-        phase    = mouse.leftButton;
+        fingerId  = 0;
+        position  = mouse.position;
+        timestamp = mouse.timestamp;
+        phase     = mouse.leftButton;
     }
 
     // If not first touch frame and state is
@@ -78,6 +81,7 @@ GestureState PanGestureRecognizer::recognitionLoop(TouchState touch, MouseState
             this->startPosition = position;
             this->position      = position;
             this->lastFingerId  = fingerId;
+            this->addSample(position, timestamp);
             this->panEvent.fire(getCurrentStatus(), soundToPlay);
             break;
         case TouchPhase::STAY:
@@ -122,30 +126,29 @@ GestureState PanGestureRecognizer::recognitionLoop(TouchState touch, MouseState
                     this->state = GestureState::END;
             }
 
-            // If last touch frame, calculate acceleration
+            // The release sample repeats the last known position, so only
+            // moving samples take part in the velocity estimation
+            if (phase == TouchPhase::STAY)
+                this->addSample(position, timestamp);
 
-            static PanAcceleration acceleration;
-            if (this->state == GestureState::END)
+            if (this->state == GestureState::START || this->state == GestureState::STAY || this->state == GestureState::END)
             {
-                float time = posHistory.size() / FPS;
+                PanGestureStatus state = getCurrentStatus();
 
-                float distanceX = posHistory[posHistory.size()].x - posHistory[0].x;
-                float distanceY = posHistory[posHistory.size()].y - posHistory[0].y;
+                // If last touch frame, calculate acceleration
+                if (this->state == GestureState::END)
+                {
+                    Point velocity = this->estimateVelocity(timestamp);
 
-                float velocityX = distanceX / time;
-                float velocityY = distanceY / time;
+                    state.acceleration.velocity = velocity;
 
-                acceleration.time.x = -fabs(velocityX) / PAN_SCROLL_ACCELERATION;
-                acceleration.time.y = -fabs(velocityY) / PAN_SCROLL_ACCELERATION;
+                    state.acceleration.time.x = -fabs(velocity.x) / PAN_SCROLL_ACCELERATION;
+                    state.acceleration.time.y = -fabs(velocity.y) / PAN_SCROLL_ACCELERATION;
 
-                acceleration.distance.x = velocityX * acceleration.time.x / 2;
-                acceleration.distance.y = velocityY * acceleration.time.y / 2;
-            }
+                    state.acceleration.distance.x = velocity.x * state.acceleration.time.x / 2;
+                    state.acceleration.distance.y = velocity.y * state.acceleration.time.y / 2;
+                }
 
-            if (this->state == GestureState::START || this->state == GestureState::STAY || this->state == GestureState::END)
-            {
-                PanGestureStatus state = getCurrentStatus();
-                state.acceleration     = acceleration;
                 this->panEvent.fire(state, soundToPlay);
             }
 
@@ -155,15 +158,67 @@ GestureState PanGestureRecognizer::recognitionLoop(TouchState touch, MouseState
             break;
     }
 
-    // Add current state to history
-    posHistory.insert(posHistory.begin(), this->position);
-    while (posHistory.size() > HISTORY_LIMIT)
+    lastState = this->state;
+    return this->state;
+}
+
+void PanGestureRecognizer::addSample(Point position, Time timestamp)
+{
+    this->posHistory.push_back(PanSample { position, timestamp });
+
+    // Drop samples that left the velocity window
+    size_t expired = 0;
+    while (expired < this->posHistory.size() && timestamp - this->posHistory[expired].timestamp > VELOCITY_WINDOW)
+        expired++;
+
+    if (this->posHistory.size() - expired > HISTORY_LIMIT)
+        expired = this->posHistory.size() - HISTORY_LIMIT;
+
+    this->posHistory.erase(this->posHistory.begin(), this->posHistory.begin() + expired);
+}
+
+Point PanGestureRecognizer::estimateVelocity(Time now)
+{
+    // Fit position = a + velocity * t by least squares, with t in seconds
+    // relative to now so that the sums keep their precision
+    double meanT = 0, meanX = 0, meanY = 0;
+    size_t count = 0;
+
+    for (const PanSample& sample : this->posHistory)
+    {
+        if (now - sample.timestamp > VELOCITY_WINDOW)
+            continue;
+
+        meanT += (double)(sample.timestamp - now) / 1000000.0;
+        meanX += sample.position.x;
+        meanY += sample.position.y;
+        count++;
+    }
+
+    if (count < 2)
+        return Point();
+
+    meanT /= count;
+    meanX /= count;
+    meanY /= count;
+
+    double covarianceX = 0, covarianceY = 0, variance = 0;
+    for (const PanSample& sample : this->posHistory)
     {
-        posHistory.pop_back();
+        if (now - sample.timestamp > VELOCITY_WINDOW)
+            continue;
+
+        double t = (double)(sample.timestamp - now) / 1000000.0 - meanT;
+        covarianceX += t * (sample.position.x - meanX);
+        covarianceY += t * (sample.position.y - meanY);
+        variance += t * t;
     }
 
-    lastState = this->state;
-    return this->state;
+    // All samples were taken at the same time, no way to tell the speed
+    if (variance <= 0)
+        return Point();
+
+    return Point(covarianceX / variance, covarianceY / variance);
 }
 
 PanGestureStatus PanGestureRecognizer::getCurrentStatus()
@@ -22,6 +22,7 @@ namespace brls
 [[noreturn]] void fatal(std::string message)
 {
     brls::Logger::error("Fatal error: {}", message);
+    brls::Logger::flush();
     throw std::logic_error(message);
 }
 
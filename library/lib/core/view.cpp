@@ -33,11 +33,6 @@ using namespace brls::literals;
 namespace brls
 {
 
-static bool endsWith(const std::string& data, const std::string& suffix)
-{
-    return data.find(suffix, data.size() - suffix.size()) != std::string::npos;
-}
-
 static bool startsWith(const std::string& data, const std::string& prefix)
 {
     return data.rfind(prefix, 0) == 0;
@@ -58,39 +53,13 @@ View::View()
     YGNodeStyleSetWidthAuto(this->ygNode);
     YGNodeStyleSetHeightAuto(this->ygNode);
 
-    // Register common XML attributes
-    this->registerCommonAttributes();
+    // Common XML attributes
+    this->setXMLAttributeTable(View::getXMLAttributeTable());
 
     // Default values
     Style style = Application::getStyle();
 
     this->highlightCornerRadius = style["brls/highlight/corner_radius"];
-
-    this->registerStringXMLAttribute("title", [this](std::string value) {
-        this->getAppletFrameItem()->title = value;
-    });
-
-    this->registerFilePathXMLAttribute("icon", [this](std::string value) {
-        this->getAppletFrameItem()->setIconFromFile(value);
-    });
-
-    this->registerFloatXMLAttribute("detachedX", [this](float value) {
-        this->detach();
-        this->setDetachedPositionX(value);
-    });
-
-    this->registerFloatXMLAttribute("detachedY", [this](float value) {
-        this->detach();
-        this->setDetachedPositionY(value);
-    });
-
-    this->registerFloatXMLAttribute("alpha", [this](float value) {
-        this->setAlpha(value);
-    });
-
-    this->registerBoolXMLAttribute("clipsToBounds", [this](float value) {
-        this->setClipsToBounds(value);
-    });
 }
 
 static int shakeAnimation(float t, float a) // a = amplitude
@@ -103,10 +72,12 @@ static int shakeAnimation(float t, float a) // a = amplitude
 
 void View::shakeHighlight(FocusDirection direction)
 {
-    this->highlightShaking        = true;
-    this->highlightShakeStart     = getCPUTimeUsec() / 1000;
-    this->highlightShakeDirection = direction;
-    this->highlightShakeAmplitude = std::rand() % 15 + 10;
+    ViewExtras& extras = this->getExtras();
+
+    extras.highlightShaking        = true;
+    extras.highlightShakeStart     = getTimeUsec() / 1000;
+    extras.highlightShakeDirection = direction;
+    extras.highlightShakeAmplitude = std::rand() % 15 + 10;
 }
 
 float View::getAlpha(bool child)
@@ -140,7 +111,7 @@ void View::interruptGestures(bool onlyIfUnsureState)
 
 void View::addGestureRecognizer(GestureRecognizer* recognizer)
 {
-    this->gestureRecognizers.push_back(recognizer);
+    this->getExtras().gestureRecognizers.push_back(recognizer);
 }
 
 Sound View::gestureRecognizerRequest(TouchState touch, MouseState mouse, View* firstResponder)
@@ -172,14 +143,15 @@ void View::frame(FrameContext* ctx)
     if (this->visibility != Visibility::VISIBLE)
         return;
 
+    const ViewExtras& extras = this->readExtras();
     Style style    = Application::getStyle();
     Theme oldTheme = ctx->theme;
 
     nvgSave(ctx->vg);
 
     // Theme override
-    if (this->themeOverride)
-        ctx->theme = *themeOverride;
+    if (extras.themeOverride)
+        ctx->theme = *extras.themeOverride;
 
     Rect frame   = getFrame();
     float x      = frame.getMinX();
@@ -193,21 +165,21 @@ void View::frame(FrameContext* ctx)
         this->drawBackground(ctx->vg, ctx, style);
 
         // Draw shadow
-        if (this->shadowType != ShadowType::NONE && (this->showShadow || Application::getInputType() == InputType::TOUCH))
+        if (extras.shadowType != ShadowType::NONE && (extras.showShadow || Application::getInputType() == InputType::TOUCH))
             this->drawShadow(ctx->vg, ctx, style, frame);
 
         // Draw border
-        if (this->borderThickness > 0.0f)
+        if (extras.borderThickness > 0.0f)
             this->drawBorder(ctx->vg, ctx, style, frame);
 
         this->drawLine(ctx, frame);
 
         // Draw highlight background
-        if (this->highlightAlpha > 0.0f && !this->hideHighlightBackground && !this->hideHighlight)
-            this->drawHighlight(ctx->vg, ctx->theme, this->highlightAlpha, style, true);
+        if (extras.highlightAlpha > 0.0f && !extras.hideHighlightBackground && !extras.hideHighlight)
+            this->drawHighlight(ctx->vg, ctx->theme, extras.highlightAlpha, style, true);
 
         // Draw click animation
-        if (this->clickAlpha > 0.0f)
+        if (extras.clickAlpha > 0.0f)
             this->drawClickAnimation(ctx->vg, ctx, frame);
 
         // Collapse clipping
@@ -229,7 +201,7 @@ void View::frame(FrameContext* ctx)
     }
 
     // Cleanup
-    if (this->themeOverride)
+    if (extras.themeOverride)
         ctx->theme = oldTheme;
 
     nvgRestore(ctx->vg);
@@ -237,53 +209,60 @@ void View::frame(FrameContext* ctx)
 
 void View::frameHighlight(FrameContext* ctx)
 {
-    if (this->alpha > 0.0f && this->collapseState != 0.0f && this->highlightAlpha > 0.0f && !this->hideHighlightBorder && !this->hideHighlight)
-        this->drawHighlight(ctx->vg, ctx->theme, this->highlightAlpha, Application::getStyle(), false);
+    const ViewExtras& extras = this->readExtras();
+
+    if (this->alpha > 0.0f && this->collapseState != 0.0f && extras.highlightAlpha > 0.0f && !extras.hideHighlightBorder && !extras.hideHighlight)
+        this->drawHighlight(ctx->vg, ctx->theme, extras.highlightAlpha, Application::getStyle(), false);
 }
 
 void View::resetClickAnimation()
 {
-    this->clickAlpha.stop();
+    if (this->extras)
+        this->extras->clickAlpha.stop();
 }
 
 void View::playClickAnimation(bool reverse, bool animateBack, bool force)
 {
-    if (hideClickAnimation && !force)
+    ViewExtras& extras = this->getExtras();
+
+    if (extras.hideClickAnimation && !force)
         return;
 
     this->resetClickAnimation();
 
     Style style = Application::getStyle();
 
-    this->clickAlpha.reset(reverse ? 1.0f : 0.0f);
+    extras.clickAlpha.reset(reverse ? 1.0f : 0.0f);
 
-    this->clickAlpha.addStep(
+    extras.clickAlpha.addStep(
         reverse ? 0.0f : 1.0f,
         style["brls/animations/highlight"],
         reverse ? EasingFunction::quadraticOut : EasingFunction::quadraticIn);
 
-    this->clickAlpha.setEndCallback([this, reverse, animateBack](bool finished) {
+    extras.clickAlpha.setEndCallback([this, reverse, animateBack](bool finished) {
         if (reverse || !animateBack || Application::getInputType() == InputType::TOUCH)
             return;
 
         this->playClickAnimation(true);
     });
 
-    this->clickAlpha.start();
+    extras.clickAlpha.start();
 }
 
 void View::drawClickAnimation(NVGcontext* vg, FrameContext* ctx, Rect frame)
 {
+    const ViewExtras& extras = this->readExtras();
+
     Theme theme    = ctx->theme;
     NVGcolor color = theme["brls/click_pulse"];
 
-    color.a *= this->clickAlpha;
+    color.a *= extras.clickAlpha;
 
     nvgFillColor(vg, a(color));
     nvgBeginPath(vg);
 
-    if (this->cornerRadius > 0.0f)
-        nvgRoundedRect(vg, frame.getMinX(), frame.getMinY(), frame.getWidth(), frame.getHeight(), this->cornerRadius);
+    if (extras.cornerRadius > 0.0f)
+        nvgRoundedRect(vg, frame.getMinX(), frame.getMinY(), frame.getWidth(), frame.getHeight(), extras.cornerRadius);
     else
         nvgRect(ctx->vg, frame.getMinX(), frame.getMinY(), frame.getWidth(), frame.getHeight());
 
@@ -292,24 +271,26 @@ void View::drawClickAnimation(NVGcontext* vg, FrameContext* ctx, Rect frame)
 
 void View::drawLine(FrameContext* ctx, Rect frame)
 {
+    const ViewExtras& extras = this->readExtras();
+
     // Don't setup and draw empty nvg path if there is no line to draw
-    if (this->lineTop <= 0 && this->lineRight <= 0 && this->lineBottom <= 0 && this->lineLeft <= 0)
+    if (extras.lineTop <= 0 && extras.lineRight <= 0 && extras.lineBottom <= 0 && extras.lineLeft <= 0)
         return;
 
     nvgBeginPath(ctx->vg);
-    nvgFillColor(ctx->vg, a(this->lineColor));
+    nvgFillColor(ctx->vg, a(extras.lineColor));
 
-    if (this->lineTop > 0)
-        nvgRect(ctx->vg, frame.getMinX(), frame.getMinY(), frame.size.width, this->lineTop);
+    if (extras.lineTop > 0)
+        nvgRect(ctx->vg, frame.getMinX(), frame.getMinY(), frame.size.width, extras.lineTop);
 
-    if (this->lineRight > 0)
-        nvgRect(ctx->vg, frame.getMaxX(), frame.getMinY(), this->lineRight, frame.size.height);
+    if (extras.lineRight > 0)
+        nvgRect(ctx->vg, frame.getMaxX(), frame.getMinY(), extras.lineRight, frame.size.height);
 
-    if (this->lineBottom > 0)
-        nvgRect(ctx->vg, frame.getMinX(), frame.getMaxY() - this->lineBottom, frame.size.width, this->lineBottom);
+    if (extras.lineBottom > 0)
+        nvgRect(ctx->vg, frame.getMinX(), frame.getMaxY() - extras.lineBottom, frame.size.width, extras.lineBottom);
 
-    if (this->lineLeft > 0)
-        nvgRect(ctx->vg, frame.getMinX() - this->lineLeft, frame.getMinY(), this->lineLeft, frame.size.height);
+    if (extras.lineLeft > 0)
+        nvgRect(ctx->vg, frame.getMinX() - extras.lineLeft, frame.getMinY(), extras.lineLeft, frame.size.height);
 
     nvgFill(ctx->vg);
 }
@@ -397,21 +378,25 @@ void View::drawWireframe(FrameContext* ctx, Rect frame)
 
 void View::drawBorder(NVGcontext* vg, FrameContext* ctx, Style style, Rect frame)
 {
+    const ViewExtras& extras = this->readExtras();
+
     nvgBeginPath(vg);
-    nvgStrokeColor(vg, a(this->borderColor));
-    nvgStrokeWidth(vg, this->borderThickness);
-    nvgRoundedRect(vg, frame.getMinX(), frame.getMinY(), frame.getWidth(), frame.getHeight(), this->cornerRadius);
+    nvgStrokeColor(vg, a(extras.borderColor));
+    nvgStrokeWidth(vg, extras.borderThickness);
+    nvgRoundedRect(vg, frame.getMinX(), frame.getMinY(), frame.getWidth(), frame.getHeight(), extras.cornerRadius);
     nvgStroke(vg);
 }
 
 void View::drawShadow(NVGcontext* vg, FrameContext* ctx, Style style, Rect frame)
 {
+    const ViewExtras& extras = this->readExtras();
+
     float shadowWidth   = 0.0f;
     float shadowFeather = 0.0f;
     float shadowOpacity = 0.0f;
     float shadowOffset  = 0.0f;
 
-    switch (this->shadowType)
+    switch (extras.shadowType)
     {
         case ShadowType::GENERIC:
             shadowWidth   = style["brls/shadow/width"];
@@ -429,7 +414,7 @@ void View::drawShadow(NVGcontext* vg, FrameContext* ctx, Style style, Rect frame
         vg,
         frame.getMinX(), frame.getMinY() + shadowWidth,
         frame.getWidth(), frame.getHeight(),
-        this->cornerRadius * 2, shadowFeather,
+        extras.cornerRadius * 2, shadowFeather,
         RGBA(0, 0, 0, shadowOpacity * alpha), TRANSPARENT);
 
     nvgBeginPath(vg);
@@ -439,7 +424,7 @@ void View::drawShadow(NVGcontext* vg, FrameContext* ctx, Style style, Rect frame
         frame.getMinY() - shadowOffset,
         frame.getWidth() + shadowOffset * 2,
         frame.getHeight() + shadowOffset * 3);
-    nvgRoundedRect(vg, frame.getMinX(), frame.getMinY(), frame.getWidth(), frame.getHeight(), this->cornerRadius);
+    nvgRoundedRect(vg, frame.getMinX(), frame.getMinY(), frame.getWidth(), frame.getHeight(), extras.cornerRadius);
     nvgPathWinding(vg, NVG_HOLE);
     nvgFillPaint(vg, shadowPaint);
     nvgFill(vg);
@@ -506,6 +491,8 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
     if (Application::getInputType() == InputType::TOUCH)
         return;
 
+    ViewExtras& extras = this->getExtras();
+
     nvgSave(vg);
     nvgResetScissor(vg);
 
@@ -519,30 +506,30 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
     float height = this->getHeight() + padding * 2 + strokeWidth;
 
     // Shake animation
-    if (this->highlightShaking)
+    if (extras.highlightShaking)
     {
-        Time curTime = getCPUTimeUsec() / 1000;
-        Time t       = (curTime - highlightShakeStart) / 10;
+        Time curTime = getTimeUsec() / 1000;
+        Time t       = (curTime - extras.highlightShakeStart) / 10;
 
         if (t >= style["brls/animations/highlight_shake"])
         {
-            this->highlightShaking = false;
+            extras.highlightShaking = false;
         }
         else
         {
-            switch (this->highlightShakeDirection)
+            switch (extras.highlightShakeDirection)
             {
                 case FocusDirection::RIGHT:
-                    x += shakeAnimation(t, this->highlightShakeAmplitude);
+                    x += shakeAnimation(t, extras.highlightShakeAmplitude);
                     break;
                 case FocusDirection::LEFT:
-                    x -= shakeAnimation(t, this->highlightShakeAmplitude);
+                    x -= shakeAnimation(t, extras.highlightShakeAmplitude);
                     break;
                 case FocusDirection::DOWN:
-                    y += shakeAnimation(t, this->highlightShakeAmplitude);
+                    y += shakeAnimation(t, extras.highlightShakeAmplitude);
                     break;
                 case FocusDirection::UP:
-                    y -= shakeAnimation(t, this->highlightShakeAmplitude);
+                    y -= shakeAnimation(t, extras.highlightShakeAmplitude);
                     break;
             }
         }
@@ -553,7 +540,7 @@ void View::drawHighlight(NVGcontext* vg, Theme theme, float alpha, Style style,
     {
         // Background
         NVGcolor highlightBackgroundColor = theme["brls/highlight/background"];
-        nvgFillColor(vg, RGBAf(highlightBackgroundColor.r, highlightBackgroundColor.g, highlightBackgroundColor.b, this->highlightAlpha));
+        nvgFillColor(vg, RGBAf(highlightBackgroundColor.r, highlightBackgroundColor.g, highlightBackgroundColor.b, extras.highlightAlpha));
         nvgBeginPath(vg);
         nvgRoundedRect(vg, x, y, width, height, cornerRadius);
         nvgFill(vg);
@@ -632,6 +619,8 @@ void View::setBackground(ViewBackground background)
 
 void View::drawBackground(NVGcontext* vg, FrameContext* ctx, Style style)
 {
+    const ViewExtras& extras = this->readExtras();
+
     float x      = this->getX();
     float y      = this->getY();
     float width  = this->getWidth();
@@ -680,8 +669,8 @@ void View::drawBackground(NVGcontext* vg, FrameContext* ctx, Style style)
             nvgFillColor(vg, a(this->backgroundColor));
             nvgBeginPath(vg);
 
-            if (this->cornerRadius > 0.0f)
-                nvgRoundedRect(vg, x, y, width, height, this->cornerRadius);
+            if (extras.cornerRadius > 0.0f)
+                nvgRoundedRect(vg, x, y, width, height, extras.cornerRadius);
             else
                 nvgRect(vg, x, y, width, height);
 
@@ -694,23 +683,27 @@ void View::drawBackground(NVGcontext* vg, FrameContext* ctx, Style style)
 
 ActionIdentifier View::registerAction(std::string hintText, enum ControllerButton button, ActionListener actionListener, bool hidden, bool allowRepeating, enum Sound sound)
 {
-    ActionIdentifier nextIdentifier = (this->actions.size() == 0) ? 1 : this->actions.back().identifier + 1;
+    ViewExtras& extras = this->getExtras();
+
+    ActionIdentifier nextIdentifier = (extras.actions.size() == 0) ? 1 : extras.actions.back().identifier + 1;
 
-    if (auto it = std::find(this->actions.begin(), this->actions.end(), button); it != this->actions.end())
+    if (auto it = std::find(extras.actions.begin(), extras.actions.end(), button); it != extras.actions.end())
         *it = { button, nextIdentifier, hintText, true, hidden, allowRepeating, sound, actionListener };
     else
-        this->actions.push_back({ button, nextIdentifier, hintText, true, hidden, allowRepeating, sound, actionListener });
+        extras.actions.push_back({ button, nextIdentifier, hintText, true, hidden, allowRepeating, sound, actionListener });
 
     return nextIdentifier;
 }
 
 void View::unregisterAction(ActionIdentifier identifier)
 {
+    ViewExtras& extras = this->getExtras();
+
     auto is_matched_action = [identifier](Action action) {
         return action.identifier == identifier;
     };
-    if (auto it = std::find_if(this->actions.begin(), this->actions.end(), is_matched_action); it != this->actions.end())
-        this->actions.erase(it);
+    if (auto it = std::find_if(extras.actions.begin(), extras.actions.end(), is_matched_action); it != extras.actions.end())
+        extras.actions.erase(it);
 }
 
 void View::registerClickAction(ActionListener actionListener)
@@ -720,13 +713,17 @@ void View::registerClickAction(ActionListener actionListener)
 
 void View::updateActionHint(enum ControllerButton button, std::string hintText)
 {
-    if (auto it = std::find(this->actions.begin(), this->actions.end(), button); it != this->actions.end())
+    ViewExtras& extras = this->getExtras();
+
+    if (auto it = std::find(extras.actions.begin(), extras.actions.end(), button); it != extras.actions.end())
         it->hintText = hintText;
 }
 
 void View::setActionAvailable(enum ControllerButton button, bool available)
 {
-    if (auto it = std::find(this->actions.begin(), this->actions.end(), button); it != this->actions.end())
+    ViewExtras& extras = this->getExtras();
+
+    if (auto it = std::find(extras.actions.begin(), extras.actions.end(), button); it != extras.actions.end())
         it->available = available;
 
     Application::getGlobalHintsUpdateEvent()->fire();
@@ -734,8 +731,10 @@ void View::setActionAvailable(enum ControllerButton button, bool available)
 
 void View::setActionsAvailable(bool available)
 {
-    for (int i = 0; i < this->actions.size(); i++)
-        this->actions[i].available = available;
+    ViewExtras& extras = this->getExtras();
+
+    for (int i = 0; i < extras.actions.size(); i++)
+        extras.actions[i].available = available;
 
     Application::getGlobalHintsUpdateEvent()->fire();
 }
@@ -745,8 +744,91 @@ void View::setParent(Box* parent, void* parentUserdata)
     if (this->parentUserdata)
         free(this->parentUserdata);
 
+    Box* oldParent = this->parent;
+
     this->parent         = parent;
     this->parentUserdata = parentUserdata;
+
+    if (oldParent != parent)
+        this->moveTreeIndex(oldParent);
+}
+
+void View::moveTreeIndex(Box* oldParent)
+{
+    std::unique_ptr<ViewIndex> moved;
+
+    // Take the views out of the index of the previous tree...
+    if (oldParent)
+    {
+        if (ViewIndex* oldIndex = oldParent->getTreeIndex(false))
+        {
+            moved = std::make_unique<ViewIndex>();
+            this->indexTree(oldIndex, false);
+            this->indexTree(moved.get(), true);
+        }
+    }
+    // ...or take the index of the view if it was a root
+    else
+    {
+        moved = std::move(this->treeIndex);
+    }
+
+    if (!moved || moved->isEmpty())
+        return;
+
+    // Then give them to the new tree
+    if (this->parent)
+        this->getTreeIndex(true)->merge(moved.get());
+    else
+        this->treeIndex = std::move(moved);
+}
+
+View* View::getRoot()
+{
+    View* root = this;
+
+    while (root->parent)
+        root = root->parent;
+
+    return root;
+}
+
+bool View::isAncestorOf(View* view)
+{
+    for (View* ancestor = view->parent; ancestor; ancestor = ancestor->parent)
+    {
+        if (ancestor == this)
+            return true;
+    }
+
+    return false;
+}
+
+ViewIndex* View::getTreeIndex(bool create)
+{
+    View* root = this->getRoot();
+
+    if (create && !root->treeIndex)
+        root->treeIndex = std::make_unique<ViewIndex>();
+
+    return root->treeIndex.get();
+}
+
+void View::indexTree(ViewIndex* index, bool add)
+{
+    if (!this->id.empty())
+    {
+        if (add)
+            index->add(this);
+        else
+            index->remove(this);
+    }
+
+    if (Box* box = dynamic_cast<Box*>(this))
+    {
+        for (View* child : box->getChildren())
+            child->indexTree(index, add);
+    }
 }
 
 void* View::getParentUserData()
@@ -761,7 +843,7 @@ bool View::isFocused()
 
 enum Sound View::getFocusSound()
 {
-    return this->focusSound;
+    return this->readExtras().focusSound;
 }
 
 Box* View::getParent()
@@ -1106,14 +1188,14 @@ Rect View::getFrame()
 float View::getX()
 {
     if (this->hasParent())
-        return this->getParent()->getX() + YGNodeLayoutGetLeft(this->ygNode) + this->translation.x + (isDetached() ? this->detachedOrigin.x : 0);
+        return this->getParent()->getX() + YGNodeLayoutGetLeft(this->ygNode) + this->translation.x + (isDetached() ? this->readExtras().detachedOrigin.x : 0);
     return YGNodeLayoutGetLeft(this->ygNode) + this->translation.x;
 }
 
 float View::getY()
 {
     if (this->hasParent())
-        return this->getParent()->getY() + YGNodeLayoutGetTop(this->ygNode) + this->translation.y + (isDetached() ? this->detachedOrigin.y : 0);
+        return this->getParent()->getY() + YGNodeLayoutGetTop(this->ygNode) + this->translation.y + (isDetached() ? this->readExtras().detachedOrigin.y : 0);
     return YGNodeLayoutGetTop(this->ygNode) + this->translation.y;
 }
 
@@ -1124,12 +1206,12 @@ Rect View::getLocalFrame()
 
 float View::getLocalX()
 {
-    return YGNodeLayoutGetLeft(this->ygNode) + this->translation.x + (isDetached() ? this->detachedOrigin.x : 0);
+    return YGNodeLayoutGetLeft(this->ygNode) + this->translation.x + (isDetached() ? this->readExtras().detachedOrigin.x : 0);
 }
 
 float View::getLocalY()
 {
-    return YGNodeLayoutGetTop(this->ygNode) + this->translation.y + (isDetached() ? this->detachedOrigin.y : 0);
+    return YGNodeLayoutGetTop(this->ygNode) + this->translation.y + (isDetached() ? this->readExtras().detachedOrigin.y : 0);
 }
 
 float View::getHeight(bool includeCollapse)
@@ -1149,18 +1231,20 @@ void View::detach()
 
 void View::setDetachedPosition(float x, float y)
 {
-    this->detachedOrigin.x = x;
-    this->detachedOrigin.y = y;
+    ViewExtras& extras = this->getExtras();
+
+    extras.detachedOrigin.x = x;
+    extras.detachedOrigin.y = y;
 }
 
 void View::setDetachedPositionX(float x)
 {
-    this->detachedOrigin.x = x;
+    this->getExtras().detachedOrigin.x = x;
 }
 
 void View::setDetachedPositionY(float y)
 {
-    this->detachedOrigin.y = y;
+    this->getExtras().detachedOrigin.y = y;
 }
 
 bool View::isDetached()
@@ -1170,13 +1254,15 @@ bool View::isDetached()
 
 void View::onFocusGained()
 {
+    ViewExtras& extras = this->getExtras();
+
     this->focused = true;
 
     Style style = Application::getStyle();
 
-    this->highlightAlpha.reset();
-    this->highlightAlpha.addStep(1.0f, style["brls/animations/highlight"], EasingFunction::quadraticOut);
-    this->highlightAlpha.start();
+    extras.highlightAlpha.reset();
+    extras.highlightAlpha.addStep(1.0f, style["brls/animations/highlight"], EasingFunction::quadraticOut);
+    extras.highlightAlpha.start();
 
     this->focusEvent.fire(this);
 
@@ -1191,13 +1277,15 @@ GenericEvent* View::getFocusEvent()
 
 void View::onFocusLost()
 {
+    ViewExtras& extras = this->getExtras();
+
     this->focused = false;
 
     Style style = Application::getStyle();
 
-    this->highlightAlpha.reset();
-    this->highlightAlpha.addStep(0.0f, style["brls/animations/highlight"], EasingFunction::quadraticOut);
-    this->highlightAlpha.start();
+    extras.highlightAlpha.reset();
+    extras.highlightAlpha.addStep(0.0f, style["brls/animations/highlight"], EasingFunction::quadraticOut);
+    extras.highlightAlpha.start();
 
     if (this->hasParent())
         this->getParent()->onChildFocusLost(this, this);
@@ -1232,7 +1320,7 @@ void View::show(std::function<void(void)> cb, bool animate, float animationDurat
         return;
     }
 
-    brls::Logger::debug("Showing {}", this->describe());
+    BRLS_LOG_DEBUG("Showing {}", this->describe());
 
     this->hidden = false;
 
@@ -1274,7 +1362,7 @@ void View::hide(std::function<void(void)> cb, bool animated, float animationDura
         return;
     }
 
-    brls::Logger::debug("Hiding {}", this->describe());
+    BRLS_LOG_DEBUG("Hiding {}", this->describe());
 
     this->hidden = true;
     this->fadeIn = false;
@@ -1315,7 +1403,7 @@ bool View::isHidden()
 
 void View::overrideTheme(Theme* newTheme)
 {
-    this->themeOverride = newTheme;
+    this->getExtras().themeOverride = newTheme;
 }
 
 void View::onParentFocusGained(View* focusedView)
@@ -1336,7 +1424,7 @@ void View::setCustomNavigationRoute(FocusDirection direction, View* target)
     if (!this->focusable)
         fatal("Only focusable views can have a custom navigation route");
 
-    this->customFocusByPtr[direction] = target;
+    this->getExtras().customFocusByPtr[direction] = target;
 }
 
 void View::setCustomNavigationRoute(FocusDirection direction, std::string targetId)
@@ -1344,27 +1432,33 @@ void View::setCustomNavigationRoute(FocusDirection direction, std::string target
     if (!this->focusable)
         fatal("Only focusable views can have a custom navigation route");
 
-    this->customFocusById[direction] = targetId;
+    this->getExtras().customFocusById[direction] = targetId;
 }
 
 bool View::hasCustomNavigationRouteByPtr(FocusDirection direction)
 {
-    return this->customFocusByPtr.count(direction) > 0;
+    return this->readExtras().customFocusByPtr.count(direction) > 0;
 }
 
 bool View::hasCustomNavigationRouteById(FocusDirection direction)
 {
-    return this->customFocusById.count(direction) > 0;
+    return this->readExtras().customFocusById.count(direction) > 0;
 }
 
 View* View::getCustomNavigationRoutePtr(FocusDirection direction)
 {
-    return this->customFocusByPtr[direction];
+    const ViewExtras& extras = this->readExtras();
+
+    auto it = extras.customFocusByPtr.find(direction);
+    return it != extras.customFocusByPtr.end() ? it->second : nullptr;
 }
 
 std::string View::getCustomNavigationRouteId(FocusDirection direction)
 {
-    return this->customFocusById[direction];
+    const ViewExtras& extras = this->readExtras();
+
+    auto it = extras.customFocusById.find(direction);
+    return it != extras.customFocusById.end() ? it->second : "";
 }
 
 View::~View()
@@ -1382,16 +1476,28 @@ View::~View()
     if (Application::getCurrentFocus() == this)
         Application::giveFocus(nullptr);
 
-    for (tinyxml2::XMLDocument* document : this->boundDocuments)
-        delete document;
-
     Application::tryDeinitFirstResponder(this);
-    for (GestureRecognizer* recognizer : this->gestureRecognizers)
-        delete recognizer;
+
+    // Deleted along with its parent: the root of the tree may still be there
+    if (this->parent && !this->id.empty())
+    {
+        if (ViewIndex* index = this->getTreeIndex(false))
+            index->remove(this);
+    }
+
+    if (this->extras)
+    {
+        for (tinyxml2::XMLDocument* document : this->extras->boundDocuments)
+            delete document;
+
+        for (GestureRecognizer* recognizer : this->extras->gestureRecognizers)
+            delete recognizer;
+
+        this->extras->clickAlpha.stop();
+        this->extras->highlightAlpha.stop();
+    }
 
     alpha.stop();
-    clickAlpha.stop();
-    highlightAlpha.stop();
     collapseState.stop();
 
     YGNodeFree(this->ygNode);
@@ -1422,224 +1528,135 @@ std::string View::getFilePathXMLAttributeValue(std::string value)
     return value;
 }
 
+void View::onThemeChanged()
+{
+    const ViewExtras& extras = this->readExtras();
+
+    const Theme& theme = Application::getTheme();
+    for (const auto& attribute : extras.themedColorAttributes)
+        this->xmlAttributes->find(attribute.first)->colorHandler(this, theme[attribute.second]);
+}
+
+// Value given to applyParsedXMLAttribute(), for applyXMLAttribute() not to parse it again
+static thread_local const XMLValue* parsedXMLValue = nullptr;
+
 bool View::applyXMLAttribute(std::string name, std::string value)
 {
+    if (parsedXMLValue && parsedXMLValue->raw == value)
+        return this->applyXMLAttributeValue(name, *parsedXMLValue);
+
+    return this->applyXMLAttributeValue(name, XMLValue(value));
+}
+
+bool View::applyParsedXMLAttribute(const std::string& name, const XMLValue& value)
+{
+    // Saved for handlers inflating other views
+    const XMLValue* previousValue = parsedXMLValue;
+    parsedXMLValue                = &value;
+
+    bool applied = this->applyXMLAttribute(name, value.raw);
+
+    parsedXMLValue = previousValue;
+    return applied;
+}
+
+bool View::applyXMLAttributeValue(const std::string& name, const XMLValue& value)
+{
+    // A new value replaces the theme color the attribute was bound to
+    if (this->extras)
+        this->extras->themedColorAttributes.erase(name);
+
+    const XMLAttributeHandlers* handlers = this->xmlAttributes->find(name);
+
+    if (!handlers)
+        return false;
+
     // String -> string
-    if (this->stringAttributes.count(name) > 0)
+    if (handlers->stringHandler)
     {
-        if (startsWith(value, "@i18n/"))
-        {
-            this->stringAttributes[name](View::getStringXMLAttributeValue(value));
-            return true;
-        }
-
-        this->stringAttributes[name](value);
+        handlers->stringHandler(this, value.i18n ? getStr(value.string) : value.string);
         return true;
     }
 
     // File path -> file path
-    if (startsWith(value, "@res/"))
+    if (value.type == XMLValueType::RES)
     {
-        std::string path = View::getFilePathXMLAttributeValue(value);
-
-        if (this->filePathAttributes.count(name) > 0)
-        {
-            this->filePathAttributes[name](path);
-            return true;
-        }
-        else
-        {
+        if (!handlers->filePathHandler)
             return false; // unknown res
-        }
-    }
-    else
-    {
-        if (this->filePathAttributes.count(name) > 0)
-        {
-            this->filePathAttributes[name](value);
-            return true;
-        }
 
-        // don't return false as it can be anything else
+        handlers->filePathHandler(this, value.path);
+        return true;
     }
-
-    // Auto -> auto
-    if (value == "auto")
+    else if (handlers->filePathHandler)
     {
-        if (this->autoAttributes.count(name) > 0)
-        {
-            this->autoAttributes[name]();
-            return true;
-        }
-        else
-        {
-            return false;
-        }
+        handlers->filePathHandler(this, value.path);
+        return true;
     }
 
-    // Ends with px -> float
-    if (endsWith(value, "px"))
+    switch (value.type)
     {
-        // Strip the px and parse the float value
-        std::string newFloat = value.substr(0, value.length() - 2);
-        try
-        {
-            float floatValue = std::stof(newFloat);
-            if (this->floatAttributes.count(name) > 0)
-            {
-                this->floatAttributes[name](floatValue);
-                return true;
-            }
-            else
-            {
+        // Auto -> auto
+        case XMLValueType::AUTO:
+            if (!handlers->autoHandler)
                 return false;
-            }
-        }
-        catch (const std::invalid_argument& exception)
-        {
-            return false;
-        }
-    }
-
-    // Ends with % -> percentage
-    if (endsWith(value, "%"))
-    {
-        // Strip the % and parse the float value
-        std::string newFloat = value.substr(0, value.length() - 1);
-        try
-        {
-            float floatValue = std::stof(newFloat);
 
-            if (floatValue < -100 || floatValue > 100)
+            handlers->autoHandler(this);
+            return true;
+        // Ends with px -> float
+        case XMLValueType::PIXELS:
+        // Valid float -> float
+        case XMLValueType::FLOAT:
+            if (!handlers->floatHandler)
                 return false;
 
-            if (this->percentageAttributes.count(name) > 0)
-            {
-                this->percentageAttributes[name](floatValue);
-                return true;
-            }
-            else
-            {
+            handlers->floatHandler(this, value.number);
+            return true;
+        // Ends with % -> percentage
+        case XMLValueType::PERCENTAGE:
+            if (!handlers->percentageHandler)
                 return false;
-            }
-        }
-        catch (const std::invalid_argument& exception)
-        {
-            return false;
-        }
-    }
-    // Starts with @style -> float
-    else if (startsWith(value, "@style/"))
-    {
-        // Parse the style name
-        std::string styleName = value.substr(7); // length of "@style/"
-        float value           = Application::getStyle()[styleName]; // will throw logic_error if the metric doesn't exist
 
-        if (this->floatAttributes.count(name) > 0)
-        {
-            this->floatAttributes[name](value);
+            handlers->percentageHandler(this, value.number);
             return true;
-        }
-        else
-        {
-            return false;
-        }
-    }
-    // Starts with with # -> color
-    else if (startsWith(value, "#"))
-    {
-        // Parse the color
-        // #RRGGBB format
-        if (value.size() == 7)
+        // Starts with @style -> float
+        case XMLValueType::STYLE:
         {
-            unsigned char r, g, b;
-            int result = sscanf(value.c_str(), "#%02hhx%02hhx%02hhx", &r, &g, &b);
+            float metric = Application::getStyle()[*value.key]; // will throw logic_error if the metric doesn't exist
 
-            if (result != 3)
+            if (!handlers->floatHandler)
                 return false;
-            else if (this->colorAttributes.count(name) > 0)
-            {
-                this->colorAttributes[name](nvgRGB(r, g, b));
-                return true;
-            }
-            else
-            {
-                return false;
-            }
-        }
-        // #RRGGBBAA format
-        else if (value.size() == 9)
-        {
-            unsigned char r, g, b, a;
-            int result = sscanf(value.c_str(), "#%02hhx%02hhx%02hhx%02hhx", &r, &g, &b, &a);
 
-            if (result != 4)
-                return false;
-            else if (this->colorAttributes.count(name) > 0)
-            {
-                this->colorAttributes[name](nvgRGBA(r, g, b, a));
-                return true;
-            }
-            else
-            {
-                return false;
-            }
-        }
-        else
-        {
-            return false;
+            handlers->floatHandler(this, metric);
+            return true;
         }
-    }
-    // Starts with @theme -> color
-    else if (startsWith(value, "@theme/"))
-    {
-        // Parse the color name
-        std::string colorName = value.substr(7); // length of "@theme/"
-        NVGcolor value        = Application::getTheme()[colorName]; // will throw logic_error if the color doesn't exist
+        // Starts with with # -> color
+        case XMLValueType::COLOR:
+            if (!handlers->colorHandler)
+                return false;
 
-        if (this->colorAttributes.count(name) > 0)
-        {
-            this->colorAttributes[name](value);
+            handlers->colorHandler(this, value.color);
             return true;
-        }
-        else
+        // Starts with @theme -> color
+        case XMLValueType::THEME:
         {
-            return false;
-        }
-    }
-    // Equals true or false -> bool
-    else if (value == "true" || value == "false")
-    {
-        bool boolValue = value == "true" ? true : false;
+            NVGcolor color = Application::getTheme()[*value.key]; // will throw logic_error if the color doesn't exist
 
-        if (this->boolAttributes.count(name) > 0)
-        {
-            this->boolAttributes[name](boolValue);
+            if (!handlers->colorHandler)
+                return false;
+
+            handlers->colorHandler(this, color);
+            this->getExtras().themedColorAttributes[name] = value.keyName;
             return true;
         }
-        else
-        {
-            return false;
-        }
-    }
+        // Equals true or false -> bool
+        case XMLValueType::BOOL:
+            if (!handlers->boolHandler)
+                return false;
 
-    // Valid float -> float, otherwise unknown attribute
-    try
-    {
-        float newValue = std::stof(value);
-        if (this->floatAttributes.count(name) > 0)
-        {
-            this->floatAttributes[name](newValue);
+            handlers->boolHandler(this, value.boolean);
             return true;
-        }
-        else
-        {
+        default:
             return false;
-        }
-    }
-    catch (const std::invalid_argument& exception)
-    {
-        return false;
     }
 }
 
@@ -1648,6 +1665,18 @@ void View::applyXMLAttributes(tinyxml2::XMLElement* element)
     if (!element)
         return;
 
+    // Elements of a template come with their values already parsed
+    if (const XMLTemplateNode* node = XMLTemplate::getNode(element))
+    {
+        for (const std::unique_ptr<XMLTemplateAttribute>& attribute : node->attributes)
+        {
+            if (!this->applyParsedXMLAttribute(attribute->name, attribute->value))
+                this->printXMLAttributeErrorMessage(element, attribute->name, attribute->value.raw);
+        }
+
+        return;
+    }
+
     for (const tinyxml2::XMLAttribute* attribute = element->FirstAttribute(); attribute != nullptr; attribute = attribute->Next())
     {
         std::string name  = attribute->Name();
@@ -1660,7 +1689,7 @@ void View::applyXMLAttributes(tinyxml2::XMLElement* element)
 
 bool View::isXMLAttributeValid(std::string attributeName)
 {
-    return this->knownAttributes.count(attributeName) > 0;
+    return this->xmlAttributes->find(attributeName) != nullptr;
 }
 
 View* View::createFromXMLResource(std::string name)
@@ -1668,40 +1697,52 @@ View* View::createFromXMLResource(std::string name)
     return View::createFromXMLFile(std::string(BRLS_RESOURCES) + "xml/" + name);
 }
 
-View* View::createFromXMLString(std::string xml)
+View* View::createFromXMLString(std::string xml, bool cache)
 {
-    tinyxml2::XMLDocument* document = new tinyxml2::XMLDocument();
-    tinyxml2::XMLError error        = document->Parse(xml.c_str());
+    tinyxml2::XMLError error;
+    std::unique_ptr<XMLTemplate> ownedTemplate;
+    XMLTemplate* xmlTemplate;
 
-    if (error != tinyxml2::XMLError::XML_SUCCESS)
+    if (cache)
+    {
+        xmlTemplate = XMLTemplate::fromString(xml, &error);
+    }
+    else
+    {
+        ownedTemplate = XMLTemplate::parseString(xml, &error);
+        xmlTemplate   = ownedTemplate.get();
+    }
+
+    if (!xmlTemplate)
         fatal("Invalid XML when creating View from XML: error " + std::to_string(error));
 
-    tinyxml2::XMLElement* root = document->RootElement();
+    tinyxml2::XMLElement* root = xmlTemplate->getRoot();
 
     if (!root)
         fatal("Invalid XML: no element found");
 
     View* view = View::createFromXMLElement(root);
-    view->bindXMLDocument(document);
+
+    if (ownedTemplate)
+        view->bindXMLTemplate(std::move(ownedTemplate));
+
     return view;
 }
 
 View* View::createFromXMLFile(std::string path)
 {
-    tinyxml2::XMLDocument* document = new tinyxml2::XMLDocument();
-    tinyxml2::XMLError error        = document->LoadFile(path.c_str());
+    tinyxml2::XMLError error;
+    XMLTemplate* xmlTemplate = XMLTemplate::fromFile(path, &error);
 
-    if (error != tinyxml2::XMLError::XML_SUCCESS)
+    if (!xmlTemplate)
         fatal("Unable to load XML file \"" + path + "\": error " + std::to_string(error));
 
-    tinyxml2::XMLElement* element = document->RootElement();
+    tinyxml2::XMLElement* element = xmlTemplate->getRoot();
 
     if (!element)
         fatal("Unable to load XML file \"" + path + "\": no root element found, is the file empty?");
 
-    View* view = View::createFromXMLElement(element);
-    view->bindXMLDocument(document);
-    return view;
+    return View::createFromXMLElement(element);
 }
 
 View* View::createFromXMLElement(tinyxml2::XMLElement* element)
@@ -1709,6 +1750,14 @@ View* View::createFromXMLElement(tinyxml2::XMLElement* element)
     if (!element)
         return nullptr;
 
+    View* view = View::createFromXMLElementWithoutChildren(element);
+    view->handleXMLElements(element);
+
+    return view;
+}
+
+View* View::createFromXMLElementWithoutChildren(tinyxml2::XMLElement* element)
+{
     std::string viewName = element->Name();
 
     // Instantiate the view
@@ -1730,27 +1779,34 @@ View* View::createFromXMLElement(tinyxml2::XMLElement* element)
     // Otherwise look in the register
     else
     {
-        if (!Application::XMLViewsRegisterContains(viewName))
-            fatal("Unknown XML tag \"" + viewName + "\"");
+        const XMLTemplateNode* node = XMLTemplate::getNode(element);
 
-        view = Application::getXMLViewCreator(viewName)();
+        if (node && node->creator)
+            view = (*node->creator)();
+        else if (Application::XMLViewsRegisterContains(viewName))
+            view = Application::getXMLViewCreator(viewName)();
+        else
+            fatal("Unknown XML tag \"" + viewName + "\"");
 
         view->applyXMLAttributes(element);
     }
 
+    return view;
+}
+
+void View::handleXMLElements(tinyxml2::XMLElement* element)
+{
     unsigned count = 0;
-    unsigned max   = view->getMaximumAllowedXMLElements();
+    unsigned max   = this->getMaximumAllowedXMLElements();
     for (tinyxml2::XMLElement* child = element->FirstChildElement(); child != nullptr; child = child->NextSiblingElement())
     {
         if (count >= max)
-            fatal("View \"" + view->describe() + "\" is only allowed to have " + std::to_string(max) + " children XML elements");
+            fatal("View \"" + this->describe() + "\" is only allowed to have " + std::to_string(max) + " children XML elements");
         else
-            view->handleXMLElement(child);
+            this->handleXMLElement(child);
 
         count++;
     }
-
-    return view;
 }
 
 void View::handleXMLElement(tinyxml2::XMLElement* element)
@@ -1760,289 +1816,271 @@ void View::handleXMLElement(tinyxml2::XMLElement* element)
 
 void View::setMaximumAllowedXMLElements(unsigned max)
 {
-    this->maximumAllowedXMLElements = max;
+    this->getExtras().maximumAllowedXMLElements = max;
 }
 
 unsigned View::getMaximumAllowedXMLElements()
 {
-    return this->maximumAllowedXMLElements;
+    return this->readExtras().maximumAllowedXMLElements;
 }
 
-void View::registerCommonAttributes()
+const XMLAttributeTable* View::getXMLAttributeTable()
 {
-    // Width
-    this->registerAutoXMLAttribute("width", [this] {
-        this->setWidth(View::AUTO);
-    });
+    static XMLAttributes<View> attributes = [] {
+        XMLAttributes<View> attributes(nullptr);
 
-    this->registerFloatXMLAttribute("width", [this](float value) {
-        this->setWidth(value);
-    });
+        // Width
+        attributes.registerAuto("width", [](View* view) {
+            view->setWidth(View::AUTO);
+        });
 
-    this->registerPercentageXMLAttribute("width", [this](float value) {
-        this->setWidthPercentage(value);
-    });
+        attributes.registerFloat("width", &View::setWidth);
 
-    // Height
-    this->registerAutoXMLAttribute("height", [this] {
-        this->setHeight(View::AUTO);
-    });
+        attributes.registerPercentage("width", &View::setWidthPercentage);
 
-    this->registerFloatXMLAttribute("height", [this](float value) {
-        this->setHeight(value);
-    });
+        // Height
+        attributes.registerAuto("height", [](View* view) {
+            view->setHeight(View::AUTO);
+        });
 
-    this->registerPercentageXMLAttribute("height", [this](float value) {
-        this->setHeightPercentage(value);
-    });
+        attributes.registerFloat("height", &View::setHeight);
 
-    // Max width
-    this->registerAutoXMLAttribute("maxWidth", [this] {
-        this->setMaxWidth(View::AUTO);
-    });
+        attributes.registerPercentage("height", &View::setHeightPercentage);
 
-    this->registerFloatXMLAttribute("maxWidth", [this](float value) {
-        this->setMaxWidth(value);
-    });
+        // Max width
+        attributes.registerAuto("maxWidth", [](View* view) {
+            view->setMaxWidth(View::AUTO);
+        });
 
-    this->registerPercentageXMLAttribute("maxWidth", [this](float percentage) {
-        this->setMaxWidthPercentage(percentage);
-    });
+        attributes.registerFloat("maxWidth", &View::setMaxWidth);
 
-    // Max height
-    this->registerAutoXMLAttribute("maxHeight", [this] {
-        this->setMaxHeight(View::AUTO);
-    });
+        attributes.registerPercentage("maxWidth", &View::setMaxWidthPercentage);
 
-    this->registerFloatXMLAttribute("maxHeight", [this](float value) {
-        this->setMaxHeight(value);
-    });
+        // Max height
+        attributes.registerAuto("maxHeight", [](View* view) {
+            view->setMaxHeight(View::AUTO);
+        });
 
-    this->registerPercentageXMLAttribute("maxHeight", [this](float percentage) {
-        this->setMaxHeightPercentage(percentage);
-    });
+        attributes.registerFloat("maxHeight", &View::setMaxHeight);
 
-    // Grow and shrink
-    this->registerFloatXMLAttribute("grow", [this](float value) {
-        this->setGrow(value);
-    });
+        attributes.registerPercentage("maxHeight", &View::setMaxHeightPercentage);
 
-    this->registerFloatXMLAttribute("shrink", [this](float value) {
-        this->setShrink(value);
-    });
+        // Grow and shrink
+        attributes.registerFloat("grow", &View::setGrow);
 
-    // Alignment
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "alignSelf", AlignSelf, this->setAlignSelf,
-        {
-            { "auto", AlignSelf::AUTO },
-            { "flexStart", AlignSelf::FLEX_START },
-            { "center", AlignSelf::CENTER },
-            { "flexEnd", AlignSelf::FLEX_END },
-            { "stretch", AlignSelf::STRETCH },
-            { "baseline", AlignSelf::BASELINE },
-            { "spaceBetween", AlignSelf::SPACE_BETWEEN },
-            { "spaceAround", AlignSelf::SPACE_AROUND },
-        });
+        attributes.registerFloat("shrink", &View::setShrink);
 
-    // Margins top
-    this->registerFloatXMLAttribute("marginTop", [this](float value) {
-        this->setMarginTop(value);
-    });
+        // Alignment
+        BRLS_REGISTER_CLASS_ENUM_XML_ATTRIBUTE(
+            attributes, "alignSelf", AlignSelf, &View::setAlignSelf,
+            {
+                { "auto", AlignSelf::AUTO },
+                { "flexStart", AlignSelf::FLEX_START },
+                { "center", AlignSelf::CENTER },
+                { "flexEnd", AlignSelf::FLEX_END },
+                { "stretch", AlignSelf::STRETCH },
+                { "baseline", AlignSelf::BASELINE },
+                { "spaceBetween", AlignSelf::SPACE_BETWEEN },
+                { "spaceAround", AlignSelf::SPACE_AROUND },
+            });
+
+        // Margins top
+        attributes.registerFloat("marginTop", &View::setMarginTop);
+
+        attributes.registerAuto("marginTop", [](View* view) {
+            view->setMarginTop(View::AUTO);
+        });
 
-    this->registerAutoXMLAttribute("marginTop", [this] {
-        this->setMarginTop(View::AUTO);
-    });
+        // Margin right
+        attributes.registerFloat("marginRight", &View::setMarginRight);
 
-    // Margin right
-    this->registerFloatXMLAttribute("marginRight", [this](float value) {
-        this->setMarginRight(value);
-    });
+        attributes.registerAuto("marginRight", [](View* view) {
+            view->setMarginRight(View::AUTO);
+        });
 
-    this->registerAutoXMLAttribute("marginRight", [this] {
-        this->setMarginRight(View::AUTO);
-    });
+        // Margin bottom
+        attributes.registerFloat("marginBottom", &View::setMarginBottom);
 
-    // Margin bottom
-    this->registerFloatXMLAttribute("marginBottom", [this](float value) {
-        this->setMarginBottom(value);
-    });
+        attributes.registerAuto("marginBottom", [](View* view) {
+            view->setMarginBottom(View::AUTO);
+        });
 
-    this->registerAutoXMLAttribute("marginBottom", [this] {
-        this->setMarginBottom(View::AUTO);
-    });
+        // Margin left
+        attributes.registerFloat("marginLeft", &View::setMarginLeft);
 
-    // Margin left
-    this->registerFloatXMLAttribute("marginLeft", [this](float value) {
-        this->setMarginLeft(value);
-    });
+        attributes.registerAuto("marginLeft", [](View* view) {
+            view->setMarginLeft(View::AUTO);
+        });
 
-    this->registerAutoXMLAttribute("marginLeft", [this] {
-        this->setMarginLeft(View::AUTO);
-    });
+        // Line
+        attributes.registerColor("lineColor", &View::setLineColor);
 
-    // Line
-    this->registerColorXMLAttribute("lineColor", [this](NVGcolor color) {
-        this->setLineColor(color);
-    });
+        attributes.registerFloat("lineTop", &View::setLineTop);
 
-    this->registerFloatXMLAttribute("lineTop", [this](float value) {
-        this->setLineTop(value);
-    });
+        attributes.registerFloat("lineRight", &View::setLineRight);
 
-    this->registerFloatXMLAttribute("lineRight", [this](float value) {
-        this->setLineRight(value);
-    });
+        attributes.registerFloat("lineBottom", &View::setLineBottom);
 
-    this->registerFloatXMLAttribute("lineBottom", [this](float value) {
-        this->setLineBottom(value);
-    });
+        attributes.registerFloat("lineLeft", &View::setLineLeft);
 
-    this->registerFloatXMLAttribute("lineLeft", [this](float value) {
-        this->setLineLeft(value);
-    });
+        // Position
+        attributes.registerFloat("positionTop", &View::setPositionTop);
 
-    // Position
-    this->registerFloatXMLAttribute("positionTop", [this](float value) {
-        this->setPositionTop(value);
-    });
+        attributes.registerFloat("positionRight", &View::setPositionRight);
 
-    this->registerFloatXMLAttribute("positionRight", [this](float value) {
-        this->setPositionRight(value);
-    });
+        attributes.registerFloat("positionBottom", &View::setPositionBottom);
 
-    this->registerFloatXMLAttribute("positionBottom", [this](float value) {
-        this->setPositionBottom(value);
-    });
+        attributes.registerFloat("positionLeft", &View::setPositionLeft);
 
-    this->registerFloatXMLAttribute("positionLeft", [this](float value) {
-        this->setPositionLeft(value);
-    });
+        attributes.registerPercentage("positionTop", &View::setPositionTopPercentage);
 
-    this->registerPercentageXMLAttribute("positionTop", [this](float value) {
-        this->setPositionTopPercentage(value);
-    });
+        attributes.registerPercentage("positionRight", &View::setPositionRightPercentage);
 
-    this->registerPercentageXMLAttribute("positionRight", [this](float value) {
-        this->setPositionRightPercentage(value);
-    });
+        attributes.registerPercentage("positionBottom", &View::setPositionBottomPercentage);
 
-    this->registerPercentageXMLAttribute("positionBottom", [this](float value) {
-        this->setPositionBottomPercentage(value);
-    });
+        attributes.registerPercentage("positionLeft", &View::setPositionLeftPercentage);
 
-    this->registerPercentageXMLAttribute("positionLeft", [this](float value) {
-        this->setPositionLeftPercentage(value);
-    });
+        BRLS_REGISTER_CLASS_ENUM_XML_ATTRIBUTE(
+            attributes, "positionType", PositionType, &View::setPositionType,
+            {
+                { "relative", PositionType::RELATIVE },
+                { "absolute", PositionType::ABSOLUTE },
+            });
 
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "positionType", PositionType, this->setPositionType,
-        {
-            { "relative", PositionType::RELATIVE },
-            { "absolute", PositionType::ABSOLUTE },
+        // Custom focus routes
+        attributes.registerString("focusUp", [](View* view, std::string value) {
+            view->setCustomNavigationRoute(FocusDirection::UP, value);
         });
 
-    // Custom focus routes
-    this->registerStringXMLAttribute("focusUp", [this](std::string value) {
-        this->setCustomNavigationRoute(FocusDirection::UP, value);
-    });
-
-    this->registerStringXMLAttribute("focusRight", [this](std::string value) {
-        this->setCustomNavigationRoute(FocusDirection::RIGHT, value);
-    });
+        attributes.registerString("focusRight", [](View* view, std::string value) {
+            view->setCustomNavigationRoute(FocusDirection::RIGHT, value);
+        });
 
-    this->registerStringXMLAttribute("focusDown", [this](std::string value) {
-        this->setCustomNavigationRoute(FocusDirection::DOWN, value);
-    });
+        attributes.registerString("focusDown", [](View* view, std::string value) {
+            view->setCustomNavigationRoute(FocusDirection::DOWN, value);
+        });
 
-    this->registerStringXMLAttribute("focusLeft", [this](std::string value) {
-        this->setCustomNavigationRoute(FocusDirection::LEFT, value);
-    });
+        attributes.registerString("focusLeft", [](View* view, std::string value) {
+            view->setCustomNavigationRoute(FocusDirection::LEFT, value);
+        });
 
-    // Shape
-    this->registerColorXMLAttribute("backgroundColor", [this](NVGcolor value) {
-        this->setBackgroundColor(value);
-    });
+        // Shape
+        attributes.registerColor("backgroundColor", &View::setBackgroundColor);
 
-    this->registerColorXMLAttribute("borderColor", [this](NVGcolor value) {
-        this->setBorderColor(value);
-    });
+        attributes.registerColor("borderColor", &View::setBorderColor);
 
-    this->registerFloatXMLAttribute("borderThickness", [this](float value) {
-        this->setBorderThickness(value);
-    });
+        attributes.registerFloat("borderThickness", &View::setBorderThickness);
 
-    this->registerFloatXMLAttribute("cornerRadius", [this](float value) {
-        this->setCornerRadius(value);
-    });
+        attributes.registerFloat("cornerRadius", &View::setCornerRadius);
 
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "shadowType", ShadowType, this->setShadowType,
-        {
+        BRLS_REGISTER_CLASS_ENUM_XML_ATTRIBUTE(
+            attributes, "shadowType", ShadowType, &View::setShadowType,
             {
-                "none",
-                ShadowType::NONE,
-            },
+                {
+                    "none",
+                    ShadowType::NONE,
+                },
+                {
+                    "generic",
+                    ShadowType::GENERIC,
+                },
+                {
+                    "custom",
+                    ShadowType::CUSTOM,
+                },
+            });
+
+        // Misc
+        BRLS_REGISTER_CLASS_ENUM_XML_ATTRIBUTE(
+            attributes, "visibility", Visibility, &View::setVisibility,
             {
-                "generic",
-                ShadowType::GENERIC,
-            },
+                { "visible", Visibility::VISIBLE },
+                { "invisible", Visibility::INVISIBLE },
+                { "gone", Visibility::GONE },
+            });
+
+        attributes.registerString("id", &View::setId);
+
+        BRLS_REGISTER_CLASS_ENUM_XML_ATTRIBUTE(
+            attributes, "background", ViewBackground, &View::setBackground,
             {
-                "custom",
-                ShadowType::CUSTOM,
-            },
+                { "sidebar", ViewBackground::SIDEBAR },
+                { "backdrop", ViewBackground::BACKDROP },
+            });
+
+        attributes.registerBool("focusable", &View::setFocusable);
+
+        attributes.registerBool("wireframe", &View::setWireframeEnabled);
+
+        // Highlight
+        attributes.registerBool("hideHighlightBackground", &View::setHideHighlightBackground);
+
+        // Highlight
+        attributes.registerBool("hideHighlightBorder", &View::setHideHighlightBorder);
+
+        // Highlight
+        attributes.registerBool("hideHighlight", &View::setHideHighlight);
+
+        attributes.registerFloat("highlightPadding", &View::setHighlightPadding);
+
+        attributes.registerFloat("highlightCornerRadius", &View::setHighlightCornerRadius);
+
+        // Applet frame item
+        attributes.registerString("title", [](View* view, std::string value) {
+            view->getAppletFrameItem()->title = value;
         });
 
-    // Misc
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "visibility", Visibility, this->setVisibility,
-        {
-            { "visible", Visibility::VISIBLE },
-            { "invisible", Visibility::INVISIBLE },
-            { "gone", Visibility::GONE },
+        attributes.registerFilePath("icon", [](View* view, std::string value) {
+            view->getAppletFrameItem()->setIconFromFile(value);
         });
 
-    this->registerStringXMLAttribute("id", [this](std::string value) {
-        this->setId(value);
-    });
+        // Detached position
+        attributes.registerFloat("detachedX", [](View* view, float value) {
+            view->detach();
+            view->setDetachedPositionX(value);
+        });
 
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "background", ViewBackground, this->setBackground,
-        {
-            { "sidebar", ViewBackground::SIDEBAR },
-            { "backdrop", ViewBackground::BACKDROP },
+        attributes.registerFloat("detachedY", [](View* view, float value) {
+            view->detach();
+            view->setDetachedPositionY(value);
         });
 
-    this->registerBoolXMLAttribute("focusable", [this](bool value) {
-        this->setFocusable(value);
-    });
+        // Misc
+        attributes.registerFloat("alpha", &View::setAlpha);
 
-    this->registerBoolXMLAttribute("wireframe", [this](bool value) {
-        this->setWireframeEnabled(value);
-    });
+        attributes.registerBool("clipsToBounds", &View::setClipsToBounds);
 
-    // Highlight
-    this->registerBoolXMLAttribute("hideHighlightBackground", [this](bool value) {
-        this->setHideHighlightBackground(value);
-    });
+        return attributes;
+    }();
 
-    // Highlight
-    this->registerBoolXMLAttribute("hideHighlightBorder", [this](bool value) {
-        this->setHideHighlightBorder(value);
-    });
+    return &attributes;
+}
 
-    // Highlight
-    this->registerBoolXMLAttribute("hideHighlight", [this](bool value) {
-        this->setHideHighlight(value);
-    });
+void View::setXMLAttributeTable(const XMLAttributeTable* table)
+{
+    this->xmlAttributes = table;
+}
 
-    this->registerFloatXMLAttribute("highlightPadding", [this](float value) {
-        this->setHighlightPadding(value);
-    });
+XMLAttributeTable* View::getOwnXMLAttributes()
+{
+    ViewExtras& extras = this->getExtras();
 
-    this->registerFloatXMLAttribute("highlightCornerRadius", [this](float value) {
-        this->setHighlightCornerRadius(value);
-    });
+    // Attributes registered on this instance go in a copy of the table of its class
+    if (!extras.ownXMLAttributes)
+    {
+        extras.ownXMLAttributes = std::make_unique<XMLAttributeTable>(this->xmlAttributes);
+        this->xmlAttributes     = extras.ownXMLAttributes.get();
+    }
+
+    return extras.ownXMLAttributes.get();
+}
+
+ViewExtras& View::getExtras()
+{
+    if (!this->extras)
+        this->extras = std::make_unique<ViewExtras>();
+
+    return *this->extras;
 }
 
 void View::setTranslationY(float translationY)
@@ -2083,7 +2121,7 @@ Visibility View::getVisibility()
 
 void View::printXMLAttributeErrorMessage(tinyxml2::XMLElement* element, std::string name, std::string value)
 {
-    if (this->knownAttributes.find(name) != this->knownAttributes.end())
+    if (this->xmlAttributes->find(name))
         fatal("Illegal value \"" + value + "\" for \"" + std::string(element->Name()) + "\" XML attribute \"" + name + "\"");
     else
         fatal("Unknown XML attribute \"" + name + "\" for tag \"" + std::string(element->Name()) + "\" (with value \"" + value + "\")");
@@ -2091,44 +2129,51 @@ void View::printXMLAttributeErrorMessage(tinyxml2::XMLElement* element, std::str
 
 void View::registerFloatXMLAttribute(std::string name, FloatAttributeHandler handler)
 {
-    this->floatAttributes[name] = handler;
-    this->knownAttributes.insert(name);
+    this->getOwnXMLAttributes()->get(name).floatHandler = [handler](View* view, float value) {
+        handler(value);
+    };
 }
 
 void View::registerPercentageXMLAttribute(std::string name, FloatAttributeHandler handler)
 {
-    this->percentageAttributes[name] = handler;
-    this->knownAttributes.insert(name);
+    this->getOwnXMLAttributes()->get(name).percentageHandler = [handler](View* view, float value) {
+        handler(value);
+    };
 }
 
 void View::registerAutoXMLAttribute(std::string name, AutoAttributeHandler handler)
 {
-    this->autoAttributes[name] = handler;
-    this->knownAttributes.insert(name);
+    this->getOwnXMLAttributes()->get(name).autoHandler = [handler](View* view) {
+        handler();
+    };
 }
 
 void View::registerStringXMLAttribute(std::string name, StringAttributeHandler handler)
 {
-    this->stringAttributes[name] = handler;
-    this->knownAttributes.insert(name);
+    this->getOwnXMLAttributes()->get(name).stringHandler = [handler](View* view, std::string value) {
+        handler(value);
+    };
 }
 
 void View::registerColorXMLAttribute(std::string name, ColorAttributeHandler handler)
 {
-    this->colorAttributes[name] = handler;
-    this->knownAttributes.insert(name);
+    this->getOwnXMLAttributes()->get(name).colorHandler = [handler](View* view, NVGcolor value) {
+        handler(value);
+    };
 }
 
 void View::registerBoolXMLAttribute(std::string name, BoolAttributeHandler handler)
 {
-    this->boolAttributes[name] = handler;
-    this->knownAttributes.insert(name);
+    this->getOwnXMLAttributes()->get(name).boolHandler = [handler](View* view, bool value) {
+        handler(value);
+    };
 }
 
 void View::registerFilePathXMLAttribute(std::string name, FilePathAttributeHandler handler)
 {
-    this->filePathAttributes[name] = handler;
-    this->knownAttributes.insert(name);
+    this->getOwnXMLAttributes()->get(name).filePathHandler = [handler](View* view, std::string value) {
+        handler(value);
+    };
 }
 
 float ntz(float value)
@@ -2141,20 +2186,65 @@ View* View::getView(std::string id)
     if (id == this->id)
         return this;
 
+    ViewIndex* index                     = this->getTreeIndex(false);
+    const std::vector<View*>* candidates = index ? index->find(id) : nullptr;
+
+    if (!candidates)
+        return nullptr;
+
+    View* result = nullptr;
+
+    for (View* candidate : *candidates)
+    {
+        if (candidate->id != id || !this->isAncestorOf(candidate))
+            continue;
+
+        // Multiple views with that ID: only the tree order tells which one comes first
+        if (result)
+            return this->searchView(id);
+
+        result = candidate;
+    }
+
+    return result;
+}
+
+View* View::searchView(const std::string& id)
+{
+    if (id == this->id)
+        return this;
+
+    if (Box* box = dynamic_cast<Box*>(this))
+    {
+        for (View* child : box->getChildren())
+        {
+            View* result = child->searchView(id);
+
+            if (result)
+                return result;
+        }
+    }
+
     return nullptr;
 }
 
 View* View::getNearestView(std::string id)
 {
-    // First try a children of ours
-    View* child = this->getView(id);
+    ViewIndex* index                     = this->getTreeIndex(false);
+    const std::vector<View*>* candidates = index ? index->find(id) : nullptr;
 
-    if (child)
-        return child;
+    if (!candidates)
+        return nullptr;
 
-    // Then go up one level and try again
-    if (this->hasParent())
-        return this->getParent()->getNearestView(id);
+    // First try a children of ours, then go up one level and try again
+    for (View* ancestor = this; ancestor; ancestor = ancestor->parent)
+    {
+        for (View* candidate : *candidates)
+        {
+            if (candidate->id == id && (candidate == ancestor || ancestor->isAncestorOf(candidate)))
+                return ancestor->getView(id);
+        }
+    }
 
     return nullptr;
 }
@@ -2164,7 +2254,16 @@ void View::setId(std::string id)
     if (id == "")
         fatal("ID cannot be empty");
 
+    if (id == this->id)
+        return;
+
+    ViewIndex* index = this->getTreeIndex(true);
+
+    if (!this->id.empty())
+        index->remove(this);
+
     this->id = id;
+    index->add(this);
 }
 
 bool View::isFocusable()
@@ -2200,7 +2299,12 @@ View* View::hitTest(Point point)
 
 void View::bindXMLDocument(tinyxml2::XMLDocument* document)
 {
-    this->boundDocuments.push_back(document);
+    this->getExtras().boundDocuments.push_back(document);
+}
+
+void View::bindXMLTemplate(std::unique_ptr<XMLTemplate> xmlTemplate)
+{
+    this->getExtras().boundTemplates.push_back(std::move(xmlTemplate));
 }
 
 void View::setWireframeEnabled(bool wireframe)
@@ -2255,6 +2359,32 @@ void View::dismiss(std::function<void(void)> cb)
     applet->popContentView(cb);
 }
 
+DeletionToken View::retainDeletionToken()
+{
+    ASYNC_RETAIN
+    return DeletionToken { this, token, tokenCounter };
+}
+
+bool View::releaseDeletionToken(DeletionToken token)
+{
+    bool deleted = *token.token;
+
+    (*token.counter)--;
+    if (*token.counter == 0)
+    {
+        delete token.token;
+        delete token.counter;
+
+        if (!deleted)
+        {
+            token.view->deletionToken        = nullptr;
+            token.view->deletionTokenCounter = nullptr;
+        }
+    }
+
+    return !deleted;
+}
+
 void View::ptrLock()
 {
     ptrLockCounter++;
@@ -0,0 +1,68 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <borealis/core/interned_key.hpp>
+#include <borealis/core/view.hpp>
+#include <borealis/core/view_index.hpp>
+
+namespace brls
+{
+
+static uint64_t hashId(const std::string& id)
+{
+    return hashKey(id.c_str(), id.size());
+}
+
+void ViewIndex::add(View* view)
+{
+    std::vector<View*>& views = this->views[hashId(view->getId())];
+
+    if (std::find(views.begin(), views.end(), view) == views.end())
+        views.push_back(view);
+}
+
+void ViewIndex::remove(View* view)
+{
+    auto it = this->views.find(hashId(view->getId()));
+    if (it == this->views.end())
+        return;
+
+    std::vector<View*>& views = it->second;
+    views.erase(std::remove(views.begin(), views.end(), view), views.end());
+
+    if (views.empty())
+        this->views.erase(it);
+}
+
+void ViewIndex::merge(ViewIndex* other)
+{
+    for (auto& entry : other->views)
+    {
+        std::vector<View*>& views = this->views[entry.first];
+        views.insert(views.end(), entry.second.begin(), entry.second.end());
+    }
+
+    other->views.clear();
+}
+
+const std::vector<View*>* ViewIndex::find(const std::string& id) const
+{
+    auto it = this->views.find(hashId(id));
+    return it != this->views.end() ? &it->second : nullptr;
+}
+
+} // namespace brls
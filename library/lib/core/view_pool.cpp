@@ -0,0 +1,121 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <borealis/core/logger.hpp>
+#include <borealis/core/view_pool.hpp>
+#include <new>
+
+namespace brls
+{
+
+void* ViewPool::allocate(size_t size, ViewPoolClassStats* stats)
+{
+    size_t sizeClass = getSizeClass(size);
+
+    std::lock_guard<std::mutex> guard(mutex);
+
+    stats->live++;
+    stats->total++;
+    if (stats->live > stats->peak)
+        stats->peak = stats->live;
+
+    if (sizeClass >= SIZE_CLASSES)
+        return ::operator new(size);
+
+    if (!freeObjects[sizeClass])
+        allocateSlab(sizeClass);
+
+    FreeObject* object     = freeObjects[sizeClass];
+    freeObjects[sizeClass] = object->next;
+    return object;
+}
+
+void ViewPool::deallocate(void* ptr, size_t size, ViewPoolClassStats* stats)
+{
+    size_t sizeClass = getSizeClass(size);
+
+    std::lock_guard<std::mutex> guard(mutex);
+
+    stats->live--;
+
+    if (sizeClass >= SIZE_CLASSES)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    FreeObject* object     = static_cast<FreeObject*>(ptr);
+    object->next           = freeObjects[sizeClass];
+    freeObjects[sizeClass] = object;
+}
+
+void ViewPool::allocateSlab(size_t sizeClass)
+{
+    size_t objectSize = (sizeClass + 1) * GRANULARITY;
+    char* slab        = static_cast<char*>(::operator new(objectSize * SLAB_CAPACITY));
+
+    reservedBytes += objectSize * SLAB_CAPACITY;
+
+    // Chain the objects in address order so that consecutive allocations are contiguous
+    for (size_t i = SLAB_CAPACITY; i > 0; i--)
+    {
+        FreeObject* object     = reinterpret_cast<FreeObject*>(slab + (i - 1) * objectSize);
+        object->next           = freeObjects[sizeClass];
+        freeObjects[sizeClass] = object;
+    }
+}
+
+ViewPoolClassStats* ViewPool::registerClass(const char* name)
+{
+    std::lock_guard<std::mutex> guard(mutex);
+
+    ViewPoolClassStats* stats = new ViewPoolClassStats();
+    stats->name               = name;
+    classes.push_back(stats);
+    return stats;
+}
+
+std::vector<ViewPoolClassStats> ViewPool::getStats()
+{
+    std::lock_guard<std::mutex> guard(mutex);
+
+    std::vector<ViewPoolClassStats> stats;
+    stats.reserve(classes.size());
+
+    for (ViewPoolClassStats* classStats : classes)
+        stats.push_back(*classStats);
+
+    return stats;
+}
+
+size_t ViewPool::getReservedBytes()
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    return reservedBytes;
+}
+
+void ViewPool::dump()
+{
+    for (const ViewPoolClassStats& stats : ViewPool::getStats())
+    {
+        if (stats.live > 0)
+            Logger::info("{}: live={} peak={} total={}", stats.name, stats.live, stats.peak, stats.total);
+    }
+
+    Logger::info("View pool: {} bytes reserved", ViewPool::getReservedBytes());
+}
+
+} // namespace brls
@@ -0,0 +1,285 @@
+/*
+    Copyright 2021 natinusala
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <stdio.h>
+
+#include <borealis/core/application.hpp>
+#include <borealis/core/compiled_layout.hpp>
+#include <borealis/core/xml_template.hpp>
+#include <stdexcept>
+
+namespace brls
+{
+
+static bool endsWith(const std::string& data, const std::string& suffix)
+{
+    return data.find(suffix, data.size() - suffix.size()) != std::string::npos;
+}
+
+static bool startsWith(const std::string& data, const std::string& prefix)
+{
+    return data.rfind(prefix, 0) == 0;
+}
+
+// Parses the float at the beginning of the string, like View::applyXMLAttribute() always did
+// Values out of the float range are not numbers, string handlers still get them
+static bool parseFloat(const std::string& value, float* result)
+{
+    try
+    {
+        *result = std::stof(value);
+        return true;
+    }
+    catch (const std::logic_error& exception) // invalid_argument or out_of_range
+    {
+        return false;
+    }
+}
+
+XMLValue::XMLValue(std::string value)
+    : raw(value)
+{
+    // String
+    this->i18n   = startsWith(value, "@i18n/");
+    this->string = this->i18n ? value.substr(6) : value;
+
+    // File path
+    if (startsWith(value, "@res/"))
+    {
+        this->type = XMLValueType::RES;
+        this->path = std::string(BRLS_RESOURCES) + value.substr(5);
+        return;
+    }
+
+    this->path = value;
+
+    if (value == "auto")
+    {
+        this->type = XMLValueType::AUTO;
+    }
+    else if (endsWith(value, "px"))
+    {
+        this->type = parseFloat(value.substr(0, value.length() - 2), &this->number) ? XMLValueType::PIXELS : XMLValueType::INVALID;
+    }
+    else if (endsWith(value, "%"))
+    {
+        if (parseFloat(value.substr(0, value.length() - 1), &this->number) && this->number >= -100 && this->number <= 100)
+            this->type = XMLValueType::PERCENTAGE;
+        else
+            this->type = XMLValueType::INVALID;
+    }
+    else if (startsWith(value, "@style/"))
+    {
+        this->type    = XMLValueType::STYLE;
+        this->keyName = value.substr(7); // length of "@style/"
+        this->key     = std::make_unique<InternedKey>(this->keyName);
+    }
+    else if (startsWith(value, "#"))
+    {
+        unsigned char r, g, b, a;
+
+        // #RRGGBB format
+        if (value.size() == 7 && sscanf(value.c_str(), "#%02hhx%02hhx%02hhx", &r, &g, &b) == 3)
+        {
+            this->type  = XMLValueType::COLOR;
+            this->color = nvgRGB(r, g, b);
+        }
+        // #RRGGBBAA format
+        else if (value.size() == 9 && sscanf(value.c_str(), "#%02hhx%02hhx%02hhx%02hhx", &r, &g, &b, &a) == 4)
+        {
+            this->type  = XMLValueType::COLOR;
+            this->color = nvgRGBA(r, g, b, a);
+        }
+        else
+        {
+            this->type = XMLValueType::INVALID;
+        }
+    }
+    else if (startsWith(value, "@theme/"))
+    {
+        this->type    = XMLValueType::THEME;
+        this->keyName = value.substr(7); // length of "@theme/"
+        this->key     = std::make_unique<InternedKey>(this->keyName);
+    }
+    else if (value == "true" || value == "false")
+    {
+        this->type    = XMLValueType::BOOL;
+        this->boolean = value == "true";
+    }
+    else if (parseFloat(value, &this->number))
+    {
+        this->type = XMLValueType::FLOAT;
+    }
+}
+
+XMLTemplate* XMLTemplate::fromString(const std::string& xml, tinyxml2::XMLError* error)
+{
+    return XMLTemplate::load(XMLTemplate::stringCache, xml, false, error);
+}
+
+std::unique_ptr<XMLTemplate> XMLTemplate::parseString(const std::string& xml, tinyxml2::XMLError* error)
+{
+    return std::unique_ptr<XMLTemplate>(XMLTemplate::create(xml, false, false, error));
+}
+
+XMLTemplate* XMLTemplate::fromFile(const std::string& path, tinyxml2::XMLError* error)
+{
+    return XMLTemplate::load(XMLTemplate::fileCache, path, true, error);
+}
+
+XMLTemplate* XMLTemplate::load(std::unordered_map<std::string, XMLTemplate*>& cache, const std::string& key, bool file, tinyxml2::XMLError* error)
+{
+    std::lock_guard<std::mutex> guard(cacheMutex);
+
+    auto it = cache.find(key);
+    if (it != cache.end())
+    {
+        *error = tinyxml2::XMLError::XML_SUCCESS;
+        return it->second;
+    }
+
+    XMLTemplate* xmlTemplate = XMLTemplate::create(key, file, true, error);
+
+    if (xmlTemplate)
+        cache[key] = xmlTemplate;
+
+    return xmlTemplate;
+}
+
+std::unique_ptr<XMLTemplate> XMLTemplate::loadFile(const std::string& path, Source source)
+{
+    tinyxml2::XMLError error;
+
+    if (source == Source::COMPILED)
+    {
+        std::lock_guard<std::mutex> guard(cacheMutex); // CompiledLayouts is loaded under the cache lock
+
+        if (!CompiledLayouts::findLayout(path))
+            return nullptr;
+
+        return std::unique_ptr<XMLTemplate>(XMLTemplate::create(path, true, true, &error));
+    }
+
+    return std::unique_ptr<XMLTemplate>(XMLTemplate::create(path, true, false, &error));
+}
+
+XMLTemplate* XMLTemplate::create(const std::string& source, bool file, bool allowCompiled, tinyxml2::XMLError* error)
+{
+    XMLTemplate* xmlTemplate = new XMLTemplate();
+
+    // Prefer the compiled layout, if the file was compiled at build time
+    if (file && allowCompiled)
+    {
+        if (const compiled::Element* root = CompiledLayouts::findLayout(source))
+        {
+            std::unordered_map<uint32_t, const std::function<View*(void)>*> creators;
+            xmlTemplate->build(root, &xmlTemplate->document, creators);
+
+            *error = tinyxml2::XMLError::XML_SUCCESS;
+            return xmlTemplate;
+        }
+    }
+
+    *error = file ? xmlTemplate->document.LoadFile(source.c_str()) : xmlTemplate->document.Parse(source.c_str());
+
+    if (*error != tinyxml2::XMLError::XML_SUCCESS)
+    {
+        delete xmlTemplate;
+        return nullptr;
+    }
+
+    if (tinyxml2::XMLElement* root = xmlTemplate->getRoot())
+        xmlTemplate->compile(root);
+
+    return xmlTemplate;
+}
+
+void XMLTemplate::compile(tinyxml2::XMLElement* element)
+{
+    XMLTemplateNode* node = new XMLTemplateNode();
+    node->creator         = Application::findXMLViewCreator(element->Name());
+
+    for (const tinyxml2::XMLAttribute* attribute = element->FirstAttribute(); attribute != nullptr; attribute = attribute->Next())
+        node->attributes.push_back(std::make_unique<XMLTemplateAttribute>(attribute->Name(), attribute->Value()));
+
+    element->SetUserData(node);
+    this->nodes.push_back(std::unique_ptr<XMLTemplateNode>(node));
+
+    for (tinyxml2::XMLElement* child = element->FirstChildElement(); child != nullptr; child = child->NextSiblingElement())
+        this->compile(child);
+}
+
+void XMLTemplate::build(const compiled::Element* element, tinyxml2::XMLNode* parent, std::unordered_map<uint32_t, const std::function<View*(void)>*>& creators)
+{
+    const char* tag                  = CompiledLayouts::getStringValue(element->tag);
+    tinyxml2::XMLElement* xmlElement = this->document.NewElement(tag);
+    parent->InsertEndChild(xmlElement);
+
+    XMLTemplateNode* node = new XMLTemplateNode();
+
+    // Tags are interned, only look each of them up once
+    if (auto it = creators.find(element->tag); it != creators.end())
+        node->creator = it->second;
+    else
+        node->creator = creators[element->tag] = Application::findXMLViewCreator(tag);
+
+    node->attributes.reserve(element->attributesCount);
+
+    for (uint32_t i = 0; i < element->attributesCount; i++)
+    {
+        const compiled::Attribute* attribute = CompiledLayouts::getAttribute(element->firstAttribute + i);
+        const char* name                     = CompiledLayouts::getStringValue(attribute->name);
+        const char* raw                      = CompiledLayouts::getStringValue(attribute->raw);
+        const char* text                     = CompiledLayouts::getStringValue(attribute->text);
+
+        // The element is still needed for handleXMLElement() and error messages
+        xmlElement->SetAttribute(name, raw);
+
+        if (attribute->type == compiled::TYPE_UNPARSED || attribute->type > (uint8_t)XMLValueType::INVALID)
+        {
+            node->attributes.push_back(std::make_unique<XMLTemplateAttribute>(name, raw));
+            continue;
+        }
+
+        auto templateAttribute = std::make_unique<XMLTemplateAttribute>(name);
+        XMLValue& value        = templateAttribute->value;
+
+        value.raw     = raw;
+        value.type    = (XMLValueType)attribute->type;
+        value.i18n    = attribute->i18n;
+        value.string  = value.i18n ? text : raw;
+        value.path    = value.type == XMLValueType::RES ? std::string(BRLS_RESOURCES) + text : raw;
+        value.number  = attribute->number;
+        value.color   = nvgRGBAf(attribute->color[0], attribute->color[1], attribute->color[2], attribute->color[3]);
+        value.boolean = attribute->boolean;
+
+        if (value.type == XMLValueType::STYLE || value.type == XMLValueType::THEME)
+        {
+            value.keyName = text;
+            value.key     = std::make_unique<InternedKey>(CompiledLayouts::getString(attribute->text)->hash, value.keyName.c_str());
+        }
+
+        node->attributes.push_back(std::move(templateAttribute));
+    }
+
+    xmlElement->SetUserData(node);
+    this->nodes.push_back(std::unique_ptr<XMLTemplateNode>(node));
+
+    for (uint32_t child = element->firstChild; child != compiled::NONE; child = CompiledLayouts::getElement(child)->nextSibling)
+        this->build(CompiledLayouts::getElement(child), xmlElement, creators);
+}
+
+} // namespace brls
@@ -104,9 +104,9 @@ void GLFWInputManager::keyboardCallback(GLFWwindow* window, int key, int scancod
     state.pressed = action != GLFW_RELEASE;
     const char* key_name = glfwGetKeyName(key, scancode);
     if (key_name != NULL)
-        Logger::debug("Key: {} / Code: {}", key_name, key);
+        BRLS_LOG_DEBUG("Key: {} / Code: {}", key_name, key);
     else
-        Logger::debug("Key: NULL / Code: {}", key);
+        BRLS_LOG_DEBUG("Key: NULL / Code: {}", key);
     self->getKeyboardKeyStateChanged()->fire(state);
 }
 
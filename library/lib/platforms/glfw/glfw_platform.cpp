@@ -16,6 +16,7 @@
 
 #include <borealis/core/i18n.hpp>
 #include <borealis/core/logger.hpp>
+#include <borealis/core/scheduler.hpp>
 #include <borealis/platforms/glfw/glfw_platform.hpp>
 
 #define GLFW_INCLUDE_NONE
@@ -47,6 +48,11 @@ GLFWPlatform::GLFWPlatform()
     // Misc
     glfwSetTime(0.0);
 
+    // Theme
+    char* themeEnv = getenv("BOREALIS_THEME");
+    if (themeEnv != nullptr && !strcasecmp(themeEnv, "DARK"))
+        this->themeVariant = ThemeVariant::DARK;
+
     // Platform impls
     this->fontLoader  = new GLFWFontLoader();
     this->audioPlayer = new NullAudioPlayer();
@@ -99,9 +105,26 @@ bool GLFWPlatform::mainLoopIteration()
         isActive = !glfwGetWindowAttrib(this->videoContext->getGLFWWindow(), GLFW_ICONIFIED);
 
         if (isActive)
+        {
             glfwPollEvents();
+            continue;
+        }
+
+        // Nothing is drawn while iconified: sleep until the next event
+        // or until the next timer is due, then run the due timers
+        Time deadline;
+        if (Scheduler::getNextDeadline(&deadline))
+        {
+            Time timeout = deadline - getTimeUsec();
+            if (timeout > 0)
+                glfwWaitEventsTimeout(timeout / 1000000.0);
+
+            Scheduler::runDueTimers();
+        }
         else
+        {
             glfwWaitEvents();
+        }
     } while (!isActive);
 
     return !glfwWindowShouldClose(this->videoContext->getGLFWWindow());
@@ -129,11 +152,7 @@ FontLoader* GLFWPlatform::getFontLoader()
 
 ThemeVariant GLFWPlatform::getThemeVariant()
 {
-    char* themeEnv = getenv("BOREALIS_THEME");
-    if (themeEnv != nullptr && !strcasecmp(themeEnv, "DARK"))
-        return ThemeVariant::DARK;
-    else
-        return ThemeVariant::LIGHT;
+    return this->themeVariant;
 }
 
 std::string GLFWPlatform::getLocale()
@@ -32,27 +32,26 @@ void SwitchFontLoader::loadFonts()
     // Standard
     rc = plGetSharedFontByType(&font, PlSharedFontType_Standard);
     if (R_SUCCEEDED(rc))
-        Application::loadFontFromMemory(FONT_REGULAR, font.address, font.size, false);
+        this->loadFontFromMemory(FONT_REGULAR, font.address, font.size);
     else
         Logger::error("switch: could not load Standard shared font: {:#x}", rc);
 
-    // Korean
+    // Korean, not a fallback of the regular font: not needed for the first frame
     rc = plGetSharedFontByType(&font, PlSharedFontType_KO);
     if (R_SUCCEEDED(rc))
-        Application::loadFontFromMemory(FONT_KOREAN_REGULAR, font.address, font.size, false);
+        this->loadFontFromMemory(FONT_KOREAN_REGULAR, font.address, font.size, true);
     else
         Logger::error("switch: could not load Korean shared font: {:#x}", rc);
 
     // Extented (symbols)
     rc = plGetSharedFontByType(&font, PlSharedFontType_NintendoExt);
     if (R_SUCCEEDED(rc))
-        Application::loadFontFromMemory(FONT_SWITCH_ICONS, font.address, font.size, false);
+        this->loadFontFromMemory(FONT_SWITCH_ICONS, font.address, font.size);
     else
         Logger::error("switch: could not load Extented shared font: {:#x}", rc);
 
     // Material icons
-    if (!this->loadMaterialFromResources())
-        Logger::error("switch: could not load Material icons font from resources", rc);
+    this->loadMaterialFromResources();
 }
 
 } // namespace brls
@@ -128,7 +128,7 @@ SwitchInputManager::~SwitchInputManager()
 
 void SwitchInputManager::reinitVibration(int controller) 
 {
-    Logger::debug("Vibration reinit #{}", controller);
+    BRLS_LOG_DEBUG("Vibration reinit #{}", controller);
     hidInitializeVibrationDevices(m_vibration_device_handles[controller], 2, (HidNpadIdType)controller, HidNpadStyleTag_NpadJoyDual);
     sendRumbleInternal(m_vibration_device_handles[controller], m_vibration_values[controller], 0, 0);
 }
@@ -237,6 +237,7 @@ void SwitchInputManager::updateTouchStates(std::vector<RawTouchState>* states)
 
     if (hidGetTouchScreenStates(&hidState, 1))
     {
+        Time timestamp = getTimeUsec();
         for (int i = 0; i < hidState.count; i++)
         {
             RawTouchState state;
@@ -244,6 +245,7 @@ void SwitchInputManager::updateTouchStates(std::vector<RawTouchState>* states)
             state.fingerId   = hidState.touches[i].finger_id;
             state.position.x = hidState.touches[i].x / Application::windowScale;
             state.position.y = hidState.touches[i].y / Application::windowScale;
+            state.timestamp  = timestamp;
             states->push_back(state);
         }
     }
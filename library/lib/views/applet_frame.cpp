@@ -94,24 +94,11 @@ const std::string appletFrameXML = R"xml(
 
 AppletFrame::AppletFrame()
 {
-    this->inflateFromXMLString(appletFrameXML);
+    this->setXMLAttributeTable(AppletFrame::getXMLAttributeTable());
 
-    this->forwardXMLAttribute("iconInterpolation", this->icon, "interpolation");
-
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "style", HeaderStyle, this->setHeaderStyle,
-        {
-            { "regular", HeaderStyle::REGULAR },
-            { "popup", HeaderStyle::POPUP },
-        });
-
-    this->registerBoolXMLAttribute("headerHidden", [this](bool value) {
-        this->setHeaderVisibility(value ? Visibility::GONE : Visibility::VISIBLE);
-    });
+    this->inflateFromXMLString(appletFrameXML, true);
 
-    this->registerBoolXMLAttribute("footerHidden", [this](bool value) {
-        this->setFooterVisibility(value ? Visibility::GONE : Visibility::VISIBLE);
-    });
+    this->forwardXMLAttribute("iconInterpolation", this->icon, "interpolation");
 
     this->registerAction(
         "hints/back"_i18n, BUTTON_B, [this](View* view) {
@@ -121,6 +108,32 @@ AppletFrame::AppletFrame()
         false, false, SOUND_BACK);
 }
 
+const XMLAttributeTable* AppletFrame::getXMLAttributeTable()
+{
+    static XMLAttributes<AppletFrame> attributes = [] {
+        XMLAttributes<AppletFrame> attributes(Box::getXMLAttributeTable());
+
+        BRLS_REGISTER_CLASS_ENUM_XML_ATTRIBUTE(
+            attributes, "style", HeaderStyle, &AppletFrame::setHeaderStyle,
+            {
+                { "regular", HeaderStyle::REGULAR },
+                { "popup", HeaderStyle::POPUP },
+            });
+
+        attributes.registerBool("headerHidden", [](AppletFrame* frame, bool value) {
+            frame->setHeaderVisibility(value ? Visibility::GONE : Visibility::VISIBLE);
+        });
+
+        attributes.registerBool("footerHidden", [](AppletFrame* frame, bool value) {
+            frame->setFooterVisibility(value ? Visibility::GONE : Visibility::VISIBLE);
+        });
+
+        return attributes;
+    }();
+
+    return &attributes;
+}
+
 AppletFrame::AppletFrame(View* contentView)
     : AppletFrame::AppletFrame()
 {
@@ -0,0 +1,260 @@
+/*
+    Copyright 2019-2021 natinusala
+    Copyright 2019 p-sam
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+#include <borealis/core/application.hpp>
+#include <borealis/core/future.hpp>
+#include <borealis/core/util.hpp>
+#include <borealis/core/xml_template.hpp>
+#include <borealis/views/async_layout.hpp>
+#include <typeinfo>
+#include <utility>
+
+namespace brls
+{
+
+AsyncLayout::AsyncLayout()
+{
+    this->setXMLAttributeTable(AsyncLayout::getXMLAttributeTable());
+    this->setMaximumAllowedXMLElements(0);
+
+    Style style = Application::getStyle();
+
+    // Placeholder shown until the layout is inflated
+    this->spinner = new ProgressSpinner(ProgressSpinnerSize::LARGE);
+    this->spinner->setDimensions(style["brls/async_layout/spinner_size"], style["brls/async_layout/spinner_size"]);
+
+    this->setJustifyContent(JustifyContent::CENTER);
+    this->setAlignItems(AlignItems::CENTER);
+    this->addView(this->spinner);
+
+    // Hold the focus until the content is there, so that it doesn't stay on the previous activity
+    this->setFocusable(true);
+    this->setHideHighlight(true);
+}
+
+AsyncLayout::~AsyncLayout()
+{
+    // Not added to the box yet
+    if (this->root)
+        delete this->root;
+}
+
+const XMLAttributeTable* AsyncLayout::getXMLAttributeTable()
+{
+    static XMLAttributes<AsyncLayout> attributes = [] {
+        XMLAttributes<AsyncLayout> attributes(Box::getXMLAttributeTable());
+
+        attributes.registerFilePath("xml", &AsyncLayout::inflateXMLFileAsync);
+
+        return attributes;
+    }();
+
+    return &attributes;
+}
+
+void AsyncLayout::inflateXMLFileAsync(std::string path)
+{
+    if (this->started)
+        fatal("AsyncLayout " + this->describe() + " can only inflate one layout");
+
+    this->started = true;
+
+    // First phase: load, parse and resolve the template on a worker thread
+    runTask([path] {
+        tinyxml2::XMLError error;
+        XMLTemplate* xmlTemplate = XMLTemplate::fromFile(path, &error);
+
+        // Load the layouts referenced with brls:View while at it, so that they are cached when instantiated
+        if (xmlTemplate && xmlTemplate->getRoot())
+            AsyncLayout::preloadXMLViews(xmlTemplate->getRoot());
+
+        return std::make_pair(xmlTemplate, error);
+    })
+        .thenOnMain(this, [this, path](std::pair<XMLTemplate*, tinyxml2::XMLError> result) {
+            if (!result.first)
+                fatal("Invalid XML when inflating " + path + ": error " + std::to_string(result.second));
+
+            tinyxml2::XMLElement* element = result.first->getRoot();
+
+            if (!element)
+                fatal("Invalid XML: no element found");
+
+            // Second phase: instantiate the views from the template on the main thread
+            this->pending.push_back({ nullptr, element });
+            this->step();
+        });
+}
+
+void AsyncLayout::inflateXMLResAsync(std::string name)
+{
+    this->inflateXMLFileAsync(std::string(BRLS_RESOURCES) + name);
+}
+
+void AsyncLayout::inflateXMLElementAsync(tinyxml2::XMLElement* element)
+{
+    if (this->started)
+        fatal("AsyncLayout " + this->describe() + " can only inflate one layout");
+
+    this->started = true;
+
+    // The template is already there, start instantiating on the next frame
+    this->pending.push_back({ nullptr, element });
+    this->scheduleStep();
+}
+
+void AsyncLayout::preloadXMLViews(tinyxml2::XMLElement* element)
+{
+    if (std::string(element->Name()) == "brls:View")
+    {
+        if (const tinyxml2::XMLAttribute* xmlAttribute = element->FindAttribute("xml"))
+        {
+            tinyxml2::XMLError error;
+            XMLTemplate::fromFile(View::getFilePathXMLAttributeValue(xmlAttribute->Value()), &error);
+        }
+    }
+
+    for (tinyxml2::XMLElement* child = element->FirstChildElement(); child != nullptr; child = child->NextSiblingElement())
+        AsyncLayout::preloadXMLViews(child);
+}
+
+void AsyncLayout::scheduleStep()
+{
+    DeletionToken token = this->retainDeletionToken();
+
+    brls::sync([this, token] {
+        if (View::releaseDeletionToken(token))
+            this->step();
+    });
+}
+
+void AsyncLayout::step()
+{
+    Time deadline = getCPUTimeUsec() + this->inflateBudget;
+
+    // Always instantiate at least one element, even if it doesn't fit
+    do
+    {
+        PendingElement next = this->pending.back();
+        this->pending.pop_back();
+
+        this->instantiate(next);
+    } while (!this->pending.empty() && getCPUTimeUsec() < deadline);
+
+    if (this->pending.empty())
+        this->finish();
+    else
+        this->scheduleStep();
+}
+
+void AsyncLayout::instantiate(PendingElement pendingElement)
+{
+    tinyxml2::XMLElement* element = pendingElement.element;
+    View* view                    = View::createFromXMLElementWithoutChildren(element);
+
+    if (pendingElement.parent)
+        pendingElement.parent->addView(view);
+    else
+        this->root = view;
+
+    // Plain boxes add their children in order, so they can be spread across frames:
+    // same as Box::handleXMLElement(), children are added as they are instantiated
+    // Only exact Box instances are spread: subclasses of Box, even the ones that don't
+    // override handleXMLElement(), inflate all of their children in the same frame
+    if (typeid(*view) == typeid(Box))
+    {
+        unsigned count = 0;
+        for (tinyxml2::XMLElement* child = element->FirstChildElement(); child != nullptr; child = child->NextSiblingElement())
+            count++;
+
+        unsigned max = view->getMaximumAllowedXMLElements();
+        if (count > max)
+            fatal("View \"" + view->describe() + "\" is only allowed to have " + std::to_string(max) + " children XML elements");
+
+        // Pending elements are taken from the back, push the last child first
+        size_t position = this->pending.size();
+        for (tinyxml2::XMLElement* child = element->FirstChildElement(); child != nullptr; child = child->NextSiblingElement())
+            this->pending.insert(this->pending.begin() + position, { (Box*)view, child });
+    }
+    // Other views handle their children as they want, do it all at once
+    else
+    {
+        view->handleXMLElements(element);
+    }
+}
+
+void AsyncLayout::finish()
+{
+    this->removeView(this->spinner);
+    this->spinner = nullptr;
+
+    this->setJustifyContent(JustifyContent::FLEX_START);
+    this->setAlignItems(AlignItems::STRETCH);
+
+    this->inflated = this->root;
+    this->root     = nullptr;
+
+    this->inflated->setGrow(1.0f);
+    this->addView(this->inflated);
+
+    // Hand the focus over to the content
+    this->setFocusable(false);
+
+    if (Application::getCurrentFocus() == this)
+        Application::giveFocus(this);
+
+    this->inflatedEvent.fire(this->inflated);
+}
+
+bool AsyncLayout::isInflated()
+{
+    return this->inflated != nullptr;
+}
+
+View* AsyncLayout::getInflatedView()
+{
+    return this->inflated;
+}
+
+InflatedEvent* AsyncLayout::getInflatedEvent()
+{
+    return &this->inflatedEvent;
+}
+
+void AsyncLayout::setInflateBudget(Time budget)
+{
+    this->inflateBudget = budget;
+}
+
+View* AsyncLayout::create()
+{
+    return new AsyncLayout();
+}
+
+AsyncLayout* AsyncLayout::createFromXMLFile(std::string path)
+{
+    AsyncLayout* layout = new AsyncLayout();
+    layout->inflateXMLFileAsync(path);
+    return layout;
+}
+
+AsyncLayout* AsyncLayout::createFromXMLResource(std::string name)
+{
+    AsyncLayout* layout = new AsyncLayout();
+    layout->inflateXMLResAsync(name);
+    return layout;
+}
+
+} // namespace brls
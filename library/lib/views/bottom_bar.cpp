@@ -14,11 +14,8 @@
     limitations under the License.
 */
 
+#include <borealis/core/platform_status.hpp>
 #include <borealis/views/bottom_bar.hpp>
-#include <chrono>
-#include <ctime>
-#include <iomanip>
-#include <sstream>
 
 namespace brls
 {
@@ -80,22 +77,16 @@ const std::string bottomBarXML = R"xml(
 
 BottomBar::BottomBar()
 {
-    this->inflateFromXMLString(bottomBarXML);
+    this->inflateFromXMLString(bottomBarXML, true);
 
     Platform* platform = Application::getPlatform();
     battery->setVisibility(platform->canShowBatteryLevel() ? Visibility::VISIBLE : Visibility::GONE);
-}
-
-void BottomBar::draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx)
-{
-    auto timeNow   = std::chrono::system_clock::now();
-    auto in_time_t = std::chrono::system_clock::to_time_t(timeNow);
-
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&in_time_t), "%H:%M:%S");
 
-    time->setText(ss.str());
-    Box::draw(vg, x, y, width, height, style, ctx);
+    // Only relayout when the clock actually changes
+    time->setText(PlatformStatus::getTime());
+    timeSubscription = PlatformStatus::getTimeChangeEvent()->subscribe([this](std::string newTime) {
+        time->setText(newTime);
+    });
 }
 
 View* BottomBar::create()
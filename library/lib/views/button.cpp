@@ -51,7 +51,9 @@ const std::string buttonXML = R"xml(
 
 Button::Button()
 {
-    this->inflateFromXMLString(buttonXML);
+    this->setXMLAttributeTable(Button::getXMLAttributeTable());
+
+    this->inflateFromXMLString(buttonXML, true);
 
     this->forwardXMLAttribute("text", this->label);
     this->forwardXMLAttribute("singleLine", this->label);
@@ -62,32 +64,41 @@ Button::Button()
     this->forwardXMLAttribute("autoAnimate", this->label);
     this->forwardXMLAttribute("textHorizontalAlign", this->label, "horizontalAlign");
 
-    this->registerColorXMLAttribute("textColor", [this](NVGcolor color) {
-        this->setTextColor(color);
-    });
-
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "style", const ButtonStyle*, this->setStyle,
-        {
-            { "default", &BUTTONSTYLE_DEFAULT },
-            { "primary", &BUTTONSTYLE_PRIMARY },
-            { "highlight", &BUTTONSTYLE_HIGHLIGHT },
-            { "bordered", &BUTTONSTYLE_BORDERED },
-            { "borderless", &BUTTONSTYLE_BORDERLESS },
-        });
-
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "state", ButtonState, this->setState,
-        {
-            { "enabled", ButtonState::ENABLED },
-            { "disabled", ButtonState::DISABLED },
-        });
-
     this->applyStyle();
 
     this->addGestureRecognizer(new TapGestureRecognizer(this));
 }
 
+const XMLAttributeTable* Button::getXMLAttributeTable()
+{
+    static XMLAttributes<Button> attributes = [] {
+        XMLAttributes<Button> attributes(Box::getXMLAttributeTable());
+
+        attributes.registerColor("textColor", &Button::setTextColor);
+
+        BRLS_REGISTER_CLASS_ENUM_XML_ATTRIBUTE(
+            attributes, "style", const ButtonStyle*, &Button::setStyle,
+            {
+                { "default", &BUTTONSTYLE_DEFAULT },
+                { "primary", &BUTTONSTYLE_PRIMARY },
+                { "highlight", &BUTTONSTYLE_HIGHLIGHT },
+                { "bordered", &BUTTONSTYLE_BORDERED },
+                { "borderless", &BUTTONSTYLE_BORDERLESS },
+            });
+
+        BRLS_REGISTER_CLASS_ENUM_XML_ATTRIBUTE(
+            attributes, "state", ButtonState, &Button::setState,
+            {
+                { "enabled", ButtonState::ENABLED },
+                { "disabled", ButtonState::DISABLED },
+            });
+
+        return attributes;
+    }();
+
+    return &attributes;
+}
+
 void Button::applyStyle()
 {
     Style style = Application::getStyle();
@@ -140,6 +151,12 @@ void Button::applyStyle()
         this->setBorderColor(theme[borderColor]);
 }
 
+void Button::onThemeChanged()
+{
+    Box::onThemeChanged();
+    this->applyStyle();
+}
+
 void Button::onFocusGained()
 {
     Box::onFocusGained();
@@ -82,6 +82,12 @@ void BooleanCell::scaleTick()
     detail->setFontSize(baseDetailTextSize * scale);
 }
 
+void BooleanCell::onThemeChanged()
+{
+    DetailCell::onThemeChanged();
+    updateUI();
+}
+
 View* BooleanCell::create()
 {
     return new BooleanCell();
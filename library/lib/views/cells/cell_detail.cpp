@@ -50,7 +50,7 @@ const std::string detailCellXML = R"xml(
 
 DetailCell::DetailCell()
 {
-    this->inflateFromXMLString(detailCellXML);
+    this->inflateFromXMLString(detailCellXML, true);
 }
 
 void DetailCell::setText(std::string title)
@@ -77,6 +77,12 @@ void InputCell::updateUI()
     }
 }
 
+void InputCell::onThemeChanged()
+{
+    DetailCell::onThemeChanged();
+    updateUI();
+}
+
 View* InputCell::create()
 {
     return new InputCell();
@@ -121,6 +127,12 @@ void InputNumericCell::updateUI()
     this->detail->setTextColor(theme["brls/list/listItem_value_color"]);
 }
 
+void InputNumericCell::onThemeChanged()
+{
+    DetailCell::onThemeChanged();
+    updateUI();
+}
+
 View* InputNumericCell::create()
 {
     return new InputNumericCell();
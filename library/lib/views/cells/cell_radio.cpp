@@ -98,7 +98,7 @@ View* CheckBox::create()
 
 RadioCell::RadioCell()
 {
-    this->inflateFromXMLString(radioCellXML);
+    this->inflateFromXMLString(radioCellXML, true);
 }
 
 void RadioCell::setSelected(bool selected)
@@ -115,6 +115,12 @@ bool RadioCell::getSelected()
     return this->selected;
 }
 
+void RadioCell::onThemeChanged()
+{
+    RecyclerCell::onThemeChanged();
+    this->setSelected(this->selected);
+}
+
 View* RadioCell::create()
 {
     return new RadioCell();
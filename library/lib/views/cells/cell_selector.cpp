@@ -60,6 +60,12 @@ void SelectorCell::updateUI()
     this->detail->setText(text);
 }
 
+void SelectorCell::onThemeChanged()
+{
+    DetailCell::onThemeChanged();
+    detail->setTextColor(Application::getTheme()["brls/list/listItem_value_color"]);
+}
+
 View* SelectorCell::create()
 {
     return new SelectorCell();
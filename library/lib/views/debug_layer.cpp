@@ -35,8 +35,8 @@ DebugLayer::DebugLayer()
     contentView->setWidth(600);
     contentView->setBackgroundColor(RGBA(0, 0, 0, 80));
 
-    Logger::getLogEvent()->subscribe([this, contentView](std::string log) {
-        brls::sync([this, contentView, log] {
+    Logger::subscribe([this, contentView](std::string_view message) {
+        brls::sync([this, contentView, log = std::string(message)] {
             Label* label = new Label();
             label->setText(log);
             label->setFontSize(8);
@@ -138,7 +138,7 @@ const std::string dialogXML = R"xml(
 
 Dialog::Dialog(Box* contentView)
 {
-    this->inflateFromXMLString(dialogXML);
+    this->inflateFromXMLString(dialogXML, true);
     container->addView(contentView);
 
     appletFrame->registerAction(
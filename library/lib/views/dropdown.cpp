@@ -108,7 +108,7 @@ Dropdown::Dropdown(std::string title, std::vector<std::string> values, ValueSele
     , selected(selected)
     , dismissCb(dismissCb)
 {
-    this->inflateFromXMLString(dropdownFrameXML);
+    this->inflateFromXMLString(dropdownFrameXML, true);
     this->title->setText(title);
 
     recycler->estimatedRowHeight = Application::getStyle()["brls/dropdown/listItemHeight"];
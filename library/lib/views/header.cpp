@@ -58,15 +58,24 @@ const std::string headerXML = R"xml(
 
 Header::Header()
 {
-    this->inflateFromXMLString(headerXML);
+    this->setXMLAttributeTable(Header::getXMLAttributeTable());
 
-    this->registerStringXMLAttribute("title", [this](std::string value) {
-        this->setTitle(value);
-    });
+    this->inflateFromXMLString(headerXML, true);
+}
+
+const XMLAttributeTable* Header::getXMLAttributeTable()
+{
+    static XMLAttributes<Header> attributes = [] {
+        XMLAttributes<Header> attributes(Box::getXMLAttributeTable());
+
+        attributes.registerString("title", &Header::setTitle);
+
+        attributes.registerString("subtitle", &Header::setSubtitle);
+
+        return attributes;
+    }();
 
-    this->registerStringXMLAttribute("subtitle", [this](std::string value) {
-        this->setSubtitle(value);
-    });
+    return &attributes;
 }
 
 void Header::setTitle(std::string title)
@@ -14,9 +14,11 @@
     limitations under the License.
 */
 
+#include <bitset>
 #include <borealis/core/application.hpp>
 #include <borealis/core/i18n.hpp>
 #include <borealis/core/logger.hpp>
+#include <borealis/core/thread.hpp>
 #include <borealis/core/touch/tap_gesture.hpp>
 #include <borealis/core/util.hpp>
 #include <borealis/views/applet_frame.hpp>
@@ -53,29 +55,63 @@ const std::string hintXML = R"xml(
     </brls:Box>
 )xml";
 
-Hint::Hint(Action action)
+Hint::Hint(ControllerButton button)
     : Box(Axis::ROW)
-    , action(action)
+    , button(button)
 {
-    this->inflateFromXMLString(hintXML);
+    this->inflateFromXMLString(hintXML, true);
     this->setFocusable(false);
 
-    icon->setText(getKeyIcon(action.button));
-    hint->setText(action.hintText);
-
-    if (action.button != BUTTON_A && action.available && !Application::isInputBlocks())
+    // The action is looked up when tapped, it can change while the hint is shown
+    if (button != BUTTON_A)
     {
-        this->addGestureRecognizer(new TapGestureRecognizer(this, [this, action]() {
-            action.actionListener(this);
+        this->addGestureRecognizer(new TapGestureRecognizer(this, [this]() {
+            const Action* action = Hints::findAction(Application::getCurrentFocus(), this->button);
+
+            if (action && action->available && !Application::isInputBlocks())
+                action->actionListener(this);
         }));
     }
+}
 
-    if (!action.available || Application::isInputBlocks())
+void Hint::setAction(const Action& action)
+{
+    std::string iconText = getKeyIcon(this->button);
+
+    if (this->iconText != iconText)
     {
-        Theme theme = Application::getTheme();
-        icon->setTextColor(theme["brls/text_disabled"]);
-        hint->setTextColor(theme["brls/text_disabled"]);
+        this->iconText = iconText;
+        icon->setText(this->iconText);
     }
+
+    if (this->hintText != action.hintText)
+    {
+        this->hintText = action.hintText;
+        hint->setText(this->hintText);
+    }
+
+    bool enabled = action.available && !Application::isInputBlocks();
+
+    if (this->enabled != enabled)
+    {
+        this->enabled = enabled;
+        this->applyTextColor();
+    }
+}
+
+void Hint::onThemeChanged()
+{
+    Box::onThemeChanged();
+    this->applyTextColor();
+}
+
+void Hint::applyTextColor()
+{
+    Theme theme    = Application::getTheme();
+    NVGcolor color = this->enabled ? theme["brls/text"] : theme["brls/text_disabled"];
+
+    icon->setTextColor(color);
+    hint->setTextColor(color);
 }
 
 std::string Hint::getKeyIcon(ControllerButton button, bool ignoreKeysSwap)
@@ -124,21 +160,67 @@ std::string Hint::getKeyIcon(ControllerButton button, bool ignoreKeysSwap)
 
 Hints::Hints()
 {
+    this->setXMLAttributeTable(Hints::getXMLAttributeTable());
+
     setAxis(Axis::ROW);
     setDirection(Direction::LEFT_TO_RIGHT);
 
-    hintSubscription = Application::getGlobalHintsUpdateEvent()->subscribe([this]() {
-        refillHints(Application::getCurrentFocus());
-    });
+    this->baseAction = Action { BUTTON_A, ACTION_NONE, "hints/ok"_i18n, false, false, false, Sound::SOUND_NONE, NULL };
 
-    this->registerBoolXMLAttribute("addBaseAction", [this](bool value) {
-        this->setAddUnabledAButtonAction(value);
+    Hints::instances.push_back(this);
+
+    hintSubscription = Application::getGlobalHintsUpdateEvent()->subscribe([]() {
+        Hints::scheduleRefresh();
     });
 }
 
 Hints::~Hints()
 {
-    Application::getGlobalHintsUpdateEvent()->unsubscribe(hintSubscription);
+    Hints::instances.erase(std::find(Hints::instances.begin(), Hints::instances.end(), this));
+}
+
+const XMLAttributeTable* Hints::getXMLAttributeTable()
+{
+    static XMLAttributes<Hints> attributes = [] {
+        XMLAttributes<Hints> attributes(Box::getXMLAttributeTable());
+
+        attributes.registerBool("addBaseAction", &Hints::setAddUnabledAButtonAction);
+
+        return attributes;
+    }();
+
+    return &attributes;
+}
+
+void Hints::scheduleRefresh()
+{
+    if (Hints::refreshScheduled)
+        return;
+
+    Hints::refreshScheduled = true;
+
+    brls::sync(
+        [] {
+            Hints::refreshScheduled = false;
+
+            for (Hints* hints : Hints::instances)
+                hints->refillHints(Application::getCurrentFocus());
+        },
+        SyncPriority::CRITICAL);
+}
+
+const Action* Hints::findAction(View* focusView, ControllerButton button)
+{
+    for (View* view = focusView; view != nullptr; view = view->getParent())
+    {
+        for (const Action& action : view->getActions())
+        {
+            if (!action.hidden && action.button == button)
+                return &action;
+        }
+    }
+
+    return nullptr;
 }
 
 void Hints::refillHints(View* focusView)
@@ -146,64 +228,118 @@ void Hints::refillHints(View* focusView)
     if (!focusView)
         return;
 
-    clearViews();
-
-    std::set<ControllerButton> addedButtons; // we only ever want one action per key
-    std::vector<Action> actions;
+    std::bitset<_BUTTON_MAX> addedButtons; // we only ever want one action per key
+    this->actions.clear();
 
     while (focusView != nullptr)
     {
-        for (auto& action : focusView->getActions())
+        for (const Action& action : focusView->getActions())
         {
             if (action.hidden)
                 continue;
 
-            if (addedButtons.find(action.button) != addedButtons.end())
+            if (addedButtons[action.button])
                 continue;
 
-            addedButtons.insert(action.button);
-            actions.push_back(action);
+            addedButtons[action.button] = true;
+            this->actions.push_back(&action);
         }
 
         focusView = focusView->getParent();
     }
 
-    if (addUnabledAButtonAction && std::find(actions.begin(), actions.end(), BUTTON_A) == actions.end())
+    if (addUnabledAButtonAction && !addedButtons[BUTTON_A])
+    {
+        addedButtons[BUTTON_A] = true;
+        this->actions.push_back(&this->baseAction);
+    }
+
+    // Sort the actions, keeping the original order for the same rank
+    for (size_t i = 1; i < this->actions.size(); i++)
+    {
+        const Action* action = this->actions[i];
+        size_t j             = i;
+
+        for (; j > 0 && getActionRank(this->actions[j - 1]) > getActionRank(action); j--)
+            this->actions[j] = this->actions[j - 1];
+
+        this->actions[j] = action;
+    }
+
+    // Hide the hints of the buttons that are gone
+    for (Hint* hint : this->hints)
     {
-        actions.push_back(Action { BUTTON_A, NULL, "hints/ok"_i18n, false, false, false, Sound::SOUND_NONE, NULL });
+        if (hint && !addedButtons[hint->getButton()] && hint->getVisibility() != Visibility::GONE)
+            hint->setVisibility(Visibility::GONE);
+    }
+
+    // Update the others, only creating the ones never shown before
+    for (const Action* action : this->actions)
+    {
+        Hint*& hint = this->hints[action->button];
+
+        if (!hint)
+        {
+            hint = new Hint(action->button);
+            addView(hint);
+        }
+        else if (hint->getVisibility() == Visibility::GONE)
+        {
+            hint->setVisibility(Visibility::VISIBLE);
+        }
+
+        hint->setAction(*action);
     }
 
-    // Sort the actions
-    std::stable_sort(actions.begin(), actions.end(), Hints::actionsSortFunc);
+    // Only move the hints around if they are not in order already
+    size_t next = 0;
+    bool sorted = true;
 
-    for (Action action : actions)
+    for (View* child : getChildren())
     {
-        Hint* hint = new Hint(action);
-        addView(hint);
+        if (child->getVisibility() == Visibility::GONE)
+            continue;
+
+        if (next >= this->actions.size() || child != this->hints[this->actions[next]->button])
+        {
+            sorted = false;
+            break;
+        }
+
+        next++;
+    }
+
+    if (!sorted)
+    {
+        for (const Action* action : this->actions)
+        {
+            Hint* hint = this->hints[action->button];
+            removeView(hint, false);
+            addView(hint);
+        }
     }
+
+    // The actions can go away with their views
+    this->actions.clear();
 }
 
-bool Hints::actionsSortFunc(Action a, Action b)
+int Hints::getActionRank(const Action* action)
 {
     // From left to right:
     //  - first +
     //  - then all hints that are not B and A
     //  - finally B and A
-
-    // + is before all others
-    if (a.button == BUTTON_START)
-        return true;
-
-    // A is after all others
-    if (b.button == BUTTON_A)
-        return true;
-
-    // B is after all others but A
-    if (b.button == BUTTON_B && a.button != BUTTON_A)
-        return true;
-
-    // Keep original order for the rest
-    return false;
+    switch (action->button)
+    {
+        case BUTTON_START:
+            return 0;
+        case BUTTON_B:
+            return 2;
+        case BUTTON_A:
+            return 3;
+        default:
+            return 1;
+    }
 }
 
 View* Hints::create()
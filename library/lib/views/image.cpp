@@ -108,39 +108,50 @@ static YGSize imageMeasureFunc(YGNodeRef node, float width, YGMeasureMode widthM
 
 Image::Image()
 {
+    this->setXMLAttributeTable(Image::getXMLAttributeTable());
+
     YGNodeSetMeasureFunc(this->ygNode, imageMeasureFunc);
 
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "scalingType", ImageScalingType, this->setScalingType,
-        {
-            { "fit", ImageScalingType::FIT },
-            { "fill", ImageScalingType::FILL },
-            { "stretch", ImageScalingType::STRETCH },
-            { "center", ImageScalingType::CENTER },
-        });
-
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "imageAlign", ImageAlignment, this->setImageAlign,
-        {
-            { "top", ImageAlignment::TOP },
-            { "right", ImageAlignment::RIGHT },
-            { "bottom", ImageAlignment::BOTTOM },
-            { "left", ImageAlignment::LEFT },
-            { "center", ImageAlignment::CENTER },
-        });
-
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "interpolation", ImageInterpolation, this->setInterpolation,
-        {
-            { "linear", ImageInterpolation::LINEAR },
-            { "nearest", ImageInterpolation::NEAREST },
-        });
+    setClipsToBounds(true);
+}
+
+const XMLAttributeTable* Image::getXMLAttributeTable()
+{
+    static XMLAttributes<Image> attributes = [] {
+        XMLAttributes<Image> attributes(View::getXMLAttributeTable());
 
-    this->registerFilePathXMLAttribute("image", [this](std::string value) {
-        this->setImageFromFile(value);
-    });
+        BRLS_REGISTER_CLASS_ENUM_XML_ATTRIBUTE(
+            attributes, "scalingType", ImageScalingType, &Image::setScalingType,
+            {
+                { "fit", ImageScalingType::FIT },
+                { "fill", ImageScalingType::FILL },
+                { "stretch", ImageScalingType::STRETCH },
+                { "center", ImageScalingType::CENTER },
+            });
+
+        BRLS_REGISTER_CLASS_ENUM_XML_ATTRIBUTE(
+            attributes, "imageAlign", ImageAlignment, &Image::setImageAlign,
+            {
+                { "top", ImageAlignment::TOP },
+                { "right", ImageAlignment::RIGHT },
+                { "bottom", ImageAlignment::BOTTOM },
+                { "left", ImageAlignment::LEFT },
+                { "center", ImageAlignment::CENTER },
+            });
+
+        BRLS_REGISTER_CLASS_ENUM_XML_ATTRIBUTE(
+            attributes, "interpolation", ImageInterpolation, &Image::setInterpolation,
+            {
+                { "linear", ImageInterpolation::LINEAR },
+                { "nearest", ImageInterpolation::NEAREST },
+            });
 
-    setClipsToBounds(true);
+        attributes.registerFilePath("image", &Image::setImageFromFile);
+
+        return attributes;
+    }();
+
+    return &attributes;
 }
 
 void Image::draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx)
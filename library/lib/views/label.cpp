@@ -166,6 +166,8 @@ static YGSize labelMeasureFunc(YGNodeRef node, float width, YGMeasureMode widthM
 
 Label::Label()
 {
+    this->setXMLAttributeTable(Label::getXMLAttributeTable());
+
     Style style = Application::getStyle();
     Theme theme = Application::getTheme();
 
@@ -184,52 +186,48 @@ Label::Label()
     // The view will be shortened if the text is too long
     YGNodeStyleSetMaxWidthPercent(this->ygNode, 100);
     YGNodeStyleSetMaxHeightPercent(this->ygNode, 100);
+}
 
-    // Register XML attributes
-    this->registerStringXMLAttribute("text", [this](std::string value) {
-        this->setText(value);
-    });
+const XMLAttributeTable* Label::getXMLAttributeTable()
+{
+    static XMLAttributes<Label> attributes = [] {
+        XMLAttributes<Label> attributes(View::getXMLAttributeTable());
 
-    this->registerFloatXMLAttribute("fontSize", [this](float value) {
-        this->setFontSize(value);
-    });
+        attributes.registerString("text", &Label::setText);
 
-    this->registerColorXMLAttribute("textColor", [this](NVGcolor color) {
-        this->setTextColor(color);
-    });
+        attributes.registerFloat("fontSize", &Label::setFontSize);
 
-    this->registerFloatXMLAttribute("lineHeight", [this](float value) {
-        this->setLineHeight(value);
-    });
+        attributes.registerColor("textColor", &Label::setTextColor);
 
-    this->registerBoolXMLAttribute("animated", [this](bool value) {
-        this->setAnimated(value);
-    });
+        attributes.registerFloat("lineHeight", &Label::setLineHeight);
 
-    this->registerBoolXMLAttribute("autoAnimate", [this](bool value) {
-        this->setAutoAnimate(value);
-    });
+        attributes.registerBool("animated", &Label::setAnimated);
 
-    this->registerBoolXMLAttribute("singleLine", [this](bool value) {
-        this->setSingleLine(value);
-    });
+        attributes.registerBool("autoAnimate", &Label::setAutoAnimate);
 
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "horizontalAlign", HorizontalAlign, this->setHorizontalAlign,
-        {
-            { "left", HorizontalAlign::LEFT },
-            { "center", HorizontalAlign::CENTER },
-            { "right", HorizontalAlign::RIGHT },
-        });
+        attributes.registerBool("singleLine", &Label::setSingleLine);
 
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "verticalAlign", VerticalAlign, this->setVerticalAlign,
-        {
-            { "baseline", VerticalAlign::BASELINE },
-            { "top", VerticalAlign::TOP },
-            { "center", VerticalAlign::CENTER },
-            { "bottom", VerticalAlign::BOTTOM },
-        });
+        BRLS_REGISTER_CLASS_ENUM_XML_ATTRIBUTE(
+            attributes, "horizontalAlign", HorizontalAlign, &Label::setHorizontalAlign,
+            {
+                { "left", HorizontalAlign::LEFT },
+                { "center", HorizontalAlign::CENTER },
+                { "right", HorizontalAlign::RIGHT },
+            });
+
+        BRLS_REGISTER_CLASS_ENUM_XML_ATTRIBUTE(
+            attributes, "verticalAlign", VerticalAlign, &Label::setVerticalAlign,
+            {
+                { "baseline", VerticalAlign::BASELINE },
+                { "top", VerticalAlign::TOP },
+                { "center", VerticalAlign::CENTER },
+                { "bottom", VerticalAlign::BOTTOM },
+            });
+
+        return attributes;
+    }();
+
+    return &attributes;
 }
 
 void Label::setAnimated(bool animated)
@@ -291,7 +289,16 @@ void Label::onParentFocusLost(View* focusedView)
 
 void Label::setTextColor(NVGcolor color)
 {
-    this->textColor = color;
+    this->textColor    = color;
+    this->textColorSet = true;
+}
+
+void Label::onThemeChanged()
+{
+    if (!this->textColorSet)
+        this->textColor = Application::getTheme()["brls/text"];
+
+    View::onThemeChanged();
 }
 
 void Label::setText(std::string text)
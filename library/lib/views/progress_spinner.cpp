@@ -24,11 +24,25 @@ namespace brls
 ProgressSpinner::ProgressSpinner(ProgressSpinnerSize size)
     : size(size)
 {
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE("size", ProgressSpinnerSize, this->setSize,
-        {
-            { "normal", ProgressSpinnerSize::NORMAL },
-            { "large", ProgressSpinnerSize::LARGE },
-        });
+    this->setXMLAttributeTable(ProgressSpinner::getXMLAttributeTable());
+}
+
+const XMLAttributeTable* ProgressSpinner::getXMLAttributeTable()
+{
+    static XMLAttributes<ProgressSpinner> attributes = [] {
+        XMLAttributes<ProgressSpinner> attributes(View::getXMLAttributeTable());
+
+        BRLS_REGISTER_CLASS_ENUM_XML_ATTRIBUTE(
+            attributes, "size", ProgressSpinnerSize, &ProgressSpinner::setSize,
+            {
+                { "normal", ProgressSpinnerSize::NORMAL },
+                { "large", ProgressSpinnerSize::LARGE },
+            });
+
+        return attributes;
+    }();
+
+    return &attributes;
 }
 
 void ProgressSpinner::restartAnimation()
@@ -23,12 +23,22 @@ namespace brls
 
 Rectangle::Rectangle(NVGcolor color)
 {
+    this->setXMLAttributeTable(Rectangle::getXMLAttributeTable());
+
     this->setColor(color);
+}
+
+const XMLAttributeTable* Rectangle::getXMLAttributeTable()
+{
+    static XMLAttributes<Rectangle> attributes = [] {
+        XMLAttributes<Rectangle> attributes(View::getXMLAttributeTable());
+
+        attributes.registerColor("color", &Rectangle::setColor);
+
+        return attributes;
+    }();
 
-    // Register XML attributes
-    this->registerColorXMLAttribute("color", [this](NVGcolor color) {
-        this->setColor(color);
-    });
+    return &attributes;
 }
 
 Rectangle::Rectangle()
@@ -36,18 +36,12 @@ RecyclerCell::RecyclerCell()
     });
 
     subscription = Application::getGlobalInputTypeChangeEvent()->subscribe([this](InputType type) {
-        bool isTouch = type == InputType::TOUCH;
-        this->setLineColor((!isTouch && this->focused) ? TRANSPARENT : Application::getTheme()["brls/sidebar/separator"]);
+        this->applyLineColor();
     });
 
     this->addGestureRecognizer(new TapGestureRecognizer(this));
 }
 
-RecyclerCell::~RecyclerCell()
-{
-    Application::getGlobalInputTypeChangeEvent()->unsubscribe(subscription);
-}
-
 RecyclerCell* RecyclerCell::create()
 {
     return new RecyclerCell();
@@ -78,6 +72,19 @@ void RecyclerCell::onFocusLost()
     this->setLineColor(Application::getTheme()["brls/sidebar/separator"]);
 }
 
+void RecyclerCell::onThemeChanged()
+{
+    Box::onThemeChanged();
+    this->applyLineColor();
+}
+
+void RecyclerCell::applyLineColor()
+{
+    // The line is hidden while focused, unless touch is used
+    bool isTouch = Application::getInputType() == InputType::TOUCH;
+    this->setLineColor((!isTouch && this->focused) ? TRANSPARENT : Application::getTheme()["brls/sidebar/separator"]);
+}
+
 RecyclerHeader::RecyclerHeader()
 {
     this->header = new Header();
@@ -173,34 +180,39 @@ View* RecyclerFrame::getNextCellFocus(FocusDirection direction, View* currentVie
 
 RecyclerFrame::RecyclerFrame()
 {
+    this->setXMLAttributeTable(RecyclerFrame::getXMLAttributeTable());
+
     registerCell("brls::Header", []() { return RecyclerHeader::create(); });
 
-    // Padding
-    this->registerFloatXMLAttribute("paddingTop", [this](float value) {
-        this->setPaddingTop(value);
-    });
+    this->setScrollingBehavior(ScrollingBehavior::CENTERED);
 
-    this->registerFloatXMLAttribute("paddingRight", [this](float value) {
-        this->setPaddingRight(value);
-    });
+    // Create content box
+    this->contentBox = new RecyclerContentBox(this);
+    this->setContentView(this->contentBox);
+}
 
-    this->registerFloatXMLAttribute("paddingBottom", [this](float value) {
-        this->setPaddingBottom(value);
-    });
+const XMLAttributeTable* RecyclerFrame::getXMLAttributeTable()
+{
+    static XMLAttributes<RecyclerFrame> attributes = [] {
+        XMLAttributes<RecyclerFrame> attributes(ScrollingFrame::getXMLAttributeTable());
 
-    this->registerFloatXMLAttribute("paddingLeft", [this](float value) {
-        this->setPaddingLeft(value);
-    });
+        // Padding
+        attributes.registerFloat("paddingTop", &RecyclerFrame::setPaddingTop);
 
-    this->registerFloatXMLAttribute("padding", [this](float value) {
-        this->setPadding(value);
-    });
+        attributes.registerFloat("paddingRight", &RecyclerFrame::setPaddingRight);
 
-    this->setScrollingBehavior(ScrollingBehavior::CENTERED);
+        attributes.registerFloat("paddingBottom", &RecyclerFrame::setPaddingBottom);
 
-    // Create content box
-    this->contentBox = new RecyclerContentBox(this);
-    this->setContentView(this->contentBox);
+        attributes.registerFloat("paddingLeft", &RecyclerFrame::setPaddingLeft);
+
+        attributes.registerFloat("padding", [](RecyclerFrame* recycler, float value) {
+            recycler->setPadding(value);
+        });
+
+        return attributes;
+    }();
+
+    return &attributes;
 }
 
 RecyclerFrame::~RecyclerFrame()
@@ -399,7 +411,7 @@ void RecyclerFrame::cellsRecyclingLoop()
         queueReusableCell(minCell);
         this->contentBox->removeView(minCell, false);
 
-        Logger::debug("Cell #" + std::to_string(visibleMin) + " - destroyed");
+        BRLS_LOG_DEBUG("Cell #{} - destroyed", visibleMin);
 
         visibleMin++;
     }
@@ -420,7 +432,7 @@ void RecyclerFrame::cellsRecyclingLoop()
         queueReusableCell(maxCell);
         this->contentBox->removeView(maxCell, false);
 
-        Logger::debug("Cell #" + std::to_string(visibleMax) + " - destroyed");
+        BRLS_LOG_DEBUG("Cell #{} - destroyed", visibleMax);
 
         visibleMax--;
     }
@@ -490,7 +502,7 @@ void RecyclerFrame::addCellAt(int index, int downSide)
         cacheFramesData[index].height = cellFrame.getHeight();
     }
 
-    Logger::debug("Cell #" + std::to_string(index) + " - added");
+    BRLS_LOG_DEBUG("Cell #{} - added", index);
 }
 
 void RecyclerFrame::onLayout()
@@ -25,21 +25,12 @@ namespace brls
 
 #define SCROLLING_INDICATOR_WIDTH 4
 
+// Speed of natural scrolling while a direction is held, in pixels per second
+#define NATURAL_SCROLLING_SPEED 1000.0f
+
 ScrollingFrame::ScrollingFrame()
 {
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "orientation", Orientation, this->setOrientation,
-        {
-            { "vertical", Orientation::VERTICAL},
-            { "horizontal", Orientation::HORIZONTAL},
-        });
-
-    BRLS_REGISTER_ENUM_XML_ATTRIBUTE(
-        "scrollingBehavior", ScrollingBehavior, this->setScrollingBehavior,
-        {
-            { "natural", ScrollingBehavior::NATURAL },
-            { "centered", ScrollingBehavior::CENTERED },
-        });
+    this->setXMLAttributeTable(ScrollingFrame::getXMLAttributeTable());
 
     setupScrollingIndicator();
 
@@ -58,22 +49,22 @@ ScrollingFrame::ScrollingFrame()
             return;
         }
 
-        static float startY;
         if (state.state == GestureState::START)
         {
             Application::giveFocus(this);
-            startY = this->contentOffsetY;
+            this->panStartOffsetY = this->contentOffsetY;
         }
 
-        float newScroll = startY - (state.position.y - state.startPosition.y);
+        float newScroll = this->panStartOffsetY - (state.position.y - state.startPosition.y);
 
         // Start animation
         if (state.state != GestureState::END)
             startScrolling(false, newScroll);
         else
         {
+            // Content moves the opposite way of the finger
             float time   = state.acceleration.time.y * 1000.0f;
-            float newPos = this->contentOffsetY + state.acceleration.distance.y;
+            float newPos = this->contentOffsetY - state.acceleration.distance.y;
 
             newScroll = newPos;
 
@@ -106,6 +97,37 @@ ScrollingFrame::ScrollingFrame()
     setHideHighlightBorder(true);
 }
 
+const XMLAttributeTable* ScrollingFrame::getXMLAttributeTable()
+{
+    static XMLAttributes<ScrollingFrame> attributes = [] {
+        XMLAttributes<ScrollingFrame> attributes(Box::getXMLAttributeTable());
+
+        BRLS_REGISTER_CLASS_ENUM_XML_ATTRIBUTE(
+            attributes, "orientation", Orientation, &ScrollingFrame::setOrientation,
+            {
+                { "vertical", Orientation::VERTICAL},
+                { "horizontal", Orientation::HORIZONTAL},
+            });
+
+        BRLS_REGISTER_CLASS_ENUM_XML_ATTRIBUTE(
+            attributes, "scrollingBehavior", ScrollingBehavior, &ScrollingFrame::setScrollingBehavior,
+            {
+                { "natural", ScrollingBehavior::NATURAL },
+                { "centered", ScrollingBehavior::CENTERED },
+            });
+
+        return attributes;
+    }();
+
+    return &attributes;
+}
+
+void ScrollingFrame::onThemeChanged()
+{
+    Box::onThemeChanged();
+    scrollingIndicator->setColor(Application::getTheme()["brls/text"]);
+}
+
 void ScrollingFrame::setupScrollingIndicator()
 {
     Theme theme        = Application::getTheme();
@@ -254,16 +276,17 @@ void ScrollingFrame::naturalScrollingButtonProcessing(FocusDirection focusDirect
 {
     float bottomLimit = this->getContentHeight() - this->getScrollingAreaHeight();
     float newOffset   = getContentOffsetY();
+    float distance    = NATURAL_SCROLLING_SPEED * Ticking::getFrameDelta() / 1000.0f;
     bool isBorder     = false;
     switch (focusDirection)
     {
         case FocusDirection::UP:
             isBorder = getContentOffsetY() <= 0;
-            newOffset -= (1000.0f / 60.0f);
+            newOffset -= distance;
             break;
         case FocusDirection::DOWN:
             isBorder = getContentOffsetY() >= bottomLimit;
-            newOffset += (1000.0f / 60.0f);
+            newOffset += distance;
             break;
         default:
             break;
@@ -414,6 +437,9 @@ void ScrollingFrame::startScrolling(bool animated, float newScroll)
         this->invalidate();
 }
 
+// The quadratic out easing is the exact solution of a motion with constant
+// deceleration. Being evaluated against the real time elapsed between frames,
+// a fling covers the same distance in the same time at any frame rate.
 void ScrollingFrame::animateScrolling(float newScroll, float time)
 {
     if (orientation == brls::Orientation::VERTICAL){
@@ -699,10 +725,5 @@ View* ScrollingFrame::create()
     return new ScrollingFrame();
 }
 
-ScrollingFrame::~ScrollingFrame()
-{
-    Application::getGlobalInputTypeChangeEvent()->unsubscribe(inputTypeSubscription);
-}
-
 } // namespace brls
 //vim: set ts=8 sw=4 expandtab
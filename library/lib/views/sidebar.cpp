@@ -59,11 +59,9 @@ const std::string sidebarItemXML = R"xml(
 SidebarItem::SidebarItem()
     : Box(Axis::ROW)
 {
-    this->inflateFromXMLString(sidebarItemXML);
+    this->setXMLAttributeTable(SidebarItem::getXMLAttributeTable());
 
-    this->registerStringXMLAttribute("label", [this](std::string value) {
-        this->setLabel(value);
-    });
+    this->inflateFromXMLString(sidebarItemXML, true);
 
     this->setFocusSound(SOUND_FOCUS_SIDEBAR);
 
@@ -97,27 +95,49 @@ SidebarItem::SidebarItem()
     }));
 }
 
+const XMLAttributeTable* SidebarItem::getXMLAttributeTable()
+{
+    static XMLAttributes<SidebarItem> attributes = [] {
+        XMLAttributes<SidebarItem> attributes(Box::getXMLAttributeTable());
+
+        attributes.registerString("label", &SidebarItem::setLabel);
+
+        return attributes;
+    }();
+
+    return &attributes;
+}
+
 void SidebarItem::setActive(bool active)
 {
     if (active == this->active)
         return;
 
-    Theme theme = Application::getTheme();
-
     if (active)
     {
         this->activeEvent.fire(this);
 
         this->accent->setVisibility(Visibility::VISIBLE);
-        this->label->setTextColor(theme["brls/sidebar/active_item"]);
     }
     else
     {
         this->accent->setVisibility(Visibility::INVISIBLE);
-        this->label->setTextColor(theme["brls/text"]);
     }
 
     this->active = active;
+    this->applyLabelColor();
+}
+
+void SidebarItem::onThemeChanged()
+{
+    Box::onThemeChanged();
+    this->applyLabelColor();
+}
+
+void SidebarItem::applyLabelColor()
+{
+    Theme theme = Application::getTheme();
+    this->label->setTextColor(this->active ? theme["brls/sidebar/active_item"] : theme["brls/text"]);
 }
 
 void SidebarItem::onFocusGained()
@@ -55,12 +55,7 @@ Slider::Slider()
     pointer->setShadowVisibility(true);
     pointer->setFocusable(true);
 
-    Theme theme = Application::getTheme();
-    pointer->setColor(theme["brls/slider/pointer_color"]);
-    pointer->setBorderColor(theme["brls/slider/pointer_border_color"]);
-
-    line->setColor(theme["brls/slider/line_filled"]);
-    lineEmpty->setColor(theme["brls/slider/line_empty"]);
+    this->applyColors();
 
     pointer->registerAction(
         "Right Click Blocker", BUTTON_NAV_RIGHT, [this](View* view) {
@@ -115,6 +110,22 @@ Slider::Slider()
     progress = 0.33f;
 }
 
+void Slider::onThemeChanged()
+{
+    Box::onThemeChanged();
+    this->applyColors();
+}
+
+void Slider::applyColors()
+{
+    Theme theme = Application::getTheme();
+    pointer->setColor(theme["brls/slider/pointer_color"]);
+    pointer->setBorderColor(theme["brls/slider/pointer_border_color"]);
+
+    line->setColor(theme["brls/slider/line_filled"]);
+    lineEmpty->setColor(theme["brls/slider/line_empty"]);
+}
+
 void Slider::onLayout()
 {
     Box::onLayout();
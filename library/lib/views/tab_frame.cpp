@@ -20,6 +20,7 @@
 #include <borealis/core/i18n.hpp>
 #include <borealis/core/logger.hpp>
 #include <borealis/core/util.hpp>
+#include <borealis/views/async_layout.hpp>
 #include <borealis/views/tab_frame.hpp>
 
 using namespace brls::literals;
@@ -45,7 +46,7 @@ namespace brls
 
 TabFrame::TabFrame()
 {
-    this->inflateFromXMLString(tabFrameContentXML);
+    this->inflateFromXMLString(tabFrameContentXML, true);
 }
 
 void TabFrame::addTab(std::string label, TabViewCreator creator)
@@ -115,10 +116,18 @@ void TabFrame::handleXMLElement(tinyxml2::XMLElement* element)
 
         tinyxml2::XMLElement* viewElement = element->FirstChildElement();
 
+        // async="true" spreads the tab instantiation across frames, see AsyncLayout
+        bool async = element->BoolAttribute("async", false);
+
         if (viewElement)
         {
-            this->addTab(label, [viewElement] {
-                return View::createFromXMLElement(viewElement);
+            this->addTab(label, [viewElement, async]() -> View* {
+                if (!async)
+                    return View::createFromXMLElement(viewElement);
+
+                AsyncLayout* layout = new AsyncLayout();
+                layout->inflateXMLElementAsync(viewElement);
+                return layout;
             });
 
             if (viewElement->NextSiblingElement())
@@ -35,12 +35,37 @@ BatteryWidget::BatteryWidget()
     level->setSize(Size(BATTERY_MAX_WIDTH, 10));
     level->detach();
 
-    platform = Application::getPlatform();
-    applyBackTheme(platform->getThemeVariant());
-    applyLevelTheme(platform->getThemeVariant());
+    applyBackTheme(Application::getThemeVariant());
 
     addView(level);
     addView(back);
+
+    applyStatus(PlatformStatus::getBattery());
+    statusSubscription = PlatformStatus::getBatteryChangeEvent()->subscribe([this](BatteryStatus status) {
+        applyStatus(status);
+    });
+}
+
+void BatteryWidget::applyStatus(BatteryStatus status)
+{
+    this->status = status;
+
+    if (status.charging)
+        level->setColor(RGB(140, 251, 79));
+    else
+        applyLevelTheme(Application::getThemeVariant());
+
+    level->setWidth(BATTERY_MAX_WIDTH * status.level / 100.0f);
+}
+
+void BatteryWidget::onThemeChanged()
+{
+    Box::onThemeChanged();
+
+    applyBackTheme(Application::getThemeVariant());
+
+    if (!this->status.charging)
+        applyLevelTheme(Application::getThemeVariant());
 }
 
 void BatteryWidget::applyBackTheme(ThemeVariant theme)
@@ -69,17 +94,6 @@ void BatteryWidget::applyLevelTheme(ThemeVariant theme)
     }
 }
 
-void BatteryWidget::draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx)
-{
-    if (platform->isBatteryCharging())
-        level->setColor(RGB(140, 251, 79));
-    else
-        applyLevelTheme(platform->getThemeVariant());
-
-    level->setWidth(BATTERY_MAX_WIDTH * platform->getBatteryLevel() / 100.0f);
-    Box::draw(vg, x, y, width, height, style, ctx);
-}
-
 View* BatteryWidget::create()
 {
     return new BatteryWidget();
@@ -43,13 +43,17 @@ WirelessWidget::WirelessWidget()
     _3->setScalingType(ImageScalingType::FIT);
     _3->detach();
 
-    platform = Application::getPlatform();
-    applyTheme(platform->getThemeVariant());
+    applyTheme(Application::getThemeVariant());
 
     addView(_0);
     addView(_1);
     addView(_2);
     addView(_3);
+
+    applyStatus(PlatformStatus::getWireless());
+    statusSubscription = PlatformStatus::getWirelessChangeEvent()->subscribe([this](WirelessStatus status) {
+        applyStatus(status);
+    });
 }
 
 void WirelessWidget::applyTheme(ThemeVariant theme)
@@ -71,9 +75,15 @@ void WirelessWidget::applyTheme(ThemeVariant theme)
     }
 }
 
-void WirelessWidget::draw(NVGcontext* vg, float x, float y, float width, float height, Style style, FrameContext* ctx)
+void WirelessWidget::onThemeChanged()
 {
-    if (!platform->hasWirelessConnection())
+    Box::onThemeChanged();
+    applyTheme(Application::getThemeVariant());
+}
+
+void WirelessWidget::applyStatus(WirelessStatus status)
+{
+    if (!status.connected)
     {
         _0->setVisibility(Visibility::VISIBLE);
         _1->setVisibility(Visibility::GONE);
@@ -87,8 +97,7 @@ void WirelessWidget::draw(NVGcontext* vg, float x, float y, float width, float h
         _2->setVisibility(Visibility::VISIBLE);
         _3->setVisibility(Visibility::VISIBLE);
 
-        int wifiLevel = platform->getWirelessLevel();
-        switch (wifiLevel)
+        switch (status.level)
         {
             case 0:
                 _1->setAlpha(0.2f);
@@ -112,8 +121,6 @@ void WirelessWidget::draw(NVGcontext* vg, float x, float y, float width, float h
                 break;
         }
     }
-
-    Box::draw(vg, x, y, width, height, style, ctx);
 }
 
 View* WirelessWidget::create()
@@ -0,0 +1,311 @@
+"""
+Copyright 2021 natinusala
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+# Run with Python 3
+
+# Compiles the XML layouts of a resources directory into a single
+# binary archive, loaded by brls::CompiledLayouts (see compiled_layout.hpp
+# for the format). Attribute values are parsed the same way as the
+# brls::XMLValue constructor does, so that the library doesn't have to.
+
+import argparse
+import math
+import re
+import struct
+import xml.parsers.expat
+from pathlib import Path
+
+_MAGIC = b"BRLX"
+_VERSION = 1
+
+_NONE = 0xFFFFFFFF
+_TYPE_UNPARSED = 0xFF
+
+# brls::XMLValueType
+_OTHER = 0
+_RES = 1
+_AUTO = 2
+_PIXELS = 3
+_PERCENTAGE = 4
+_STYLE = 5
+_COLOR = 6
+_THEME = 7
+_BOOL = 8
+_FLOAT = 9
+_INVALID = 10
+
+_HEADER = struct.Struct("<4sIIIIIIIII")
+_STRING = struct.Struct("<QII")
+_LAYOUT = struct.Struct("<II")
+_ELEMENT = struct.Struct("<IIIII")
+_ATTRIBUTE = struct.Struct("<IIIBBBBf4f")
+
+_FNV_OFFSET_BASIS = 0xCBF29CE484222325
+_FNV_PRIME = 0x100000001B3
+
+# Decimal floats fully understood by the compiler
+_FLOAT_RE = re.compile(r"[+-]?(\d+\.?\d*|\.\d+)([eE][+-]?\d+)?")
+
+# Anything std::stof could still make sense of (leading whitespace, hex, inf, nan...)
+_MAYBE_FLOAT_RE = re.compile(r"\s|[+-]?(\d|\.\d|inf|nan)", re.IGNORECASE)
+
+_FLOAT32 = struct.Struct("<f")
+_FLT_MIN = 2.0**-126
+
+
+def _hash_key(name):
+    """Same as brls::hashKey()"""
+    value = _FNV_OFFSET_BASIS
+    for byte in name.encode("utf-8"):
+        value = ((value ^ byte) * _FNV_PRIME) & 0xFFFFFFFFFFFFFFFF
+    return value if value != 0 else 1
+
+
+def _parse_float(value):
+    """
+    Returns (True, float) for a float parsed like std::stof() would,
+    (False, None) if std::stof() would refuse it, None if unsure.
+    """
+    match = _FLOAT_RE.match(value)
+    if match and match.end() == len(value):
+        # std::stof() throws out_of_range for values overflowing a float,
+        # which the library treats as not being a number
+        try:
+            number = _FLOAT32.unpack(_FLOAT32.pack(float(value)))[0]
+        except OverflowError:
+            return (False, None)
+        if math.isinf(number):
+            return (False, None)
+
+        # Underflows are up to the C library
+        if number != 0.0 and abs(number) < _FLT_MIN or number == 0.0 and float(value) != 0.0:
+            return None
+
+        return (True, number)
+    if not _MAYBE_FLOAT_RE.match(value):
+        return (False, None)
+    return None
+
+
+class _Value:
+    def __init__(self, raw):
+        self.raw = raw
+        self.text = raw
+        self.type = _OTHER
+        self.i18n = False
+        self.boolean = False
+        self.number = 0.0
+        self.color = (0.0, 0.0, 0.0, 0.0)
+
+        if raw.startswith("@i18n/"):
+            self.i18n = True
+            self.text = raw[len("@i18n/") :]
+
+        if raw.startswith("@res/"):
+            self.type = _RES
+            self.text = raw[len("@res/") :]
+        elif raw == "auto":
+            self.type = _AUTO
+        elif raw.endswith("px"):
+            self._parse_number(raw[:-2], _PIXELS)
+        elif raw.endswith("%"):
+            self._parse_number(raw[:-1], _PERCENTAGE)
+            if self.type == _PERCENTAGE and not (-100 <= self.number <= 100):
+                self.type = _INVALID
+        elif raw.startswith("@style/"):
+            self.type = _STYLE
+            self.text = raw[len("@style/") :]
+        elif raw.startswith("#"):
+            self._parse_color(raw)
+        elif raw.startswith("@theme/"):
+            self.type = _THEME
+            self.text = raw[len("@theme/") :]
+        elif raw in ("true", "false"):
+            self.type = _BOOL
+            self.boolean = raw == "true"
+        else:
+            parsed = _parse_float(raw)
+            if parsed is None:
+                self.type = _TYPE_UNPARSED
+            elif parsed[0]:
+                self.type = _FLOAT
+                self.number = parsed[1]
+
+    def _parse_number(self, value, type):
+        parsed = _parse_float(value)
+        if parsed is None:
+            self.type = _TYPE_UNPARSED
+        elif parsed[0]:
+            self.type = type
+            self.number = parsed[1]
+        else:
+            self.type = _INVALID
+
+    def _parse_color(self, value):
+        digits = value[1:]
+        if len(value) not in (7, 9):
+            self.type = _INVALID
+        elif not re.fullmatch(r"[0-9a-fA-F]+", digits):
+            self.type = _TYPE_UNPARSED  # let sscanf decide
+        else:
+            components = [int(digits[i : i + 2], 16) / 255.0 for i in range(0, len(digits), 2)]
+            if len(components) == 3:
+                components.append(1.0)
+            self.type = _COLOR
+            self.color = tuple(components)
+
+
+class _Element:
+    def __init__(self, tag, attributes):
+        self.tag = tag
+        self.attributes = attributes  # [(name, _Value)]
+        self.children = []
+
+
+def _parse_layout(path):
+    root = None
+    stack = []
+
+    def start(tag, attributes):
+        nonlocal root
+        element = _Element(tag, [(name, _Value(value)) for name, value in attributes])
+        if stack:
+            stack[-1].children.append(element)
+        else:
+            root = element
+        stack.append(element)
+
+    def end(tag):
+        stack.pop()
+
+    parser = xml.parsers.expat.ParserCreate()  # no namespace processing: "brls:Box" is a plain tag
+    parser.ordered_attributes = True
+    parser.StartElementHandler = lambda tag, attributes: start(tag, list(zip(attributes[::2], attributes[1::2])))
+    parser.EndElementHandler = end
+
+    with open(path, "rb") as file:
+        parser.ParseFile(file)
+
+    return root
+
+
+class _Archive:
+    def __init__(self):
+        self.strings = []
+        self.string_indices = {}
+        self.layouts = []
+        self.elements = []
+        self.attributes = []
+
+    def intern(self, string):
+        if string not in self.string_indices:
+            self.string_indices[string] = len(self.strings)
+            self.strings.append(string)
+        return self.string_indices[string]
+
+    def add_layout(self, path, root):
+        self.layouts.append((self.intern(path), self.add_element(root)))
+
+    def add_element(self, element):
+        # Elements are stored in document order, children right after their parent
+        index = len(self.elements)
+        self.elements.append(None)
+
+        first_attribute = len(self.attributes)
+        for name, value in element.attributes:
+            self.attributes.append(
+                _ATTRIBUTE.pack(
+                    self.intern(name),
+                    self.intern(value.raw),
+                    self.intern(value.text),
+                    value.type,
+                    int(value.i18n),
+                    int(value.boolean),
+                    0,
+                    value.number,
+                    *value.color,
+                )
+            )
+
+        children = [self.add_element(child) for child in element.children]
+        for i, child in enumerate(children):
+            next_sibling = children[i + 1] if i + 1 < len(children) else _NONE
+            self.elements[child] = self.elements[child][:4] + (next_sibling,)
+
+        self.elements[index] = (
+            self.intern(element.tag),
+            first_attribute,
+            len(element.attributes),
+            children[0] if children else _NONE,
+            _NONE,
+        )
+        return index
+
+    def pack(self):
+        def align(data):
+            return data + b"\0" * (-len(data) % 8)
+
+        strings_offset = _HEADER.size + (-_HEADER.size % 8)
+        layouts_offset = strings_offset + len(align(b"\0" * (_STRING.size * len(self.strings))))
+        elements_offset = layouts_offset + len(align(b"\0" * (_LAYOUT.size * len(self.layouts))))
+        attributes_offset = elements_offset + len(align(b"\0" * (_ELEMENT.size * len(self.elements))))
+        characters_offset = attributes_offset + len(align(b"\0" * (_ATTRIBUTE.size * len(self.attributes))))
+
+        strings_table = b""
+        characters = b""
+        for string in self.strings:
+            encoded = string.encode("utf-8")
+            strings_table += _STRING.pack(_hash_key(string), characters_offset + len(characters), len(encoded))
+            characters += encoded + b"\0"
+
+        header = _HEADER.pack(
+            _MAGIC,
+            _VERSION,
+            len(self.strings),
+            strings_offset,
+            len(self.layouts),
+            layouts_offset,
+            len(self.elements),
+            elements_offset,
+            len(self.attributes),
+            attributes_offset,
+        )
+
+        return (
+            align(header)
+            + align(strings_table)
+            + align(b"".join(_LAYOUT.pack(*layout) for layout in self.layouts))
+            + align(b"".join(_ELEMENT.pack(*element) for element in self.elements))
+            + align(b"".join(self.attributes))
+            + characters
+        )
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compiles the XML layouts of a resources directory into a binary archive.")
+    parser.add_argument("resources", type=Path, help="resources directory, layouts are taken from its xml directory")
+    parser.add_argument("output", type=Path, help="compiled archive to write")
+    args = parser.parse_args()
+
+    archive = _Archive()
+
+    for path in sorted((args.resources / "xml").rglob("*.xml")):
+        archive.add_layout(path.relative_to(args.resources).as_posix(), _parse_layout(path))
+
+    args.output.write_bytes(archive.pack())
+
+
+if __name__ == "__main__":
+    main()